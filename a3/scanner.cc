@@ -3,7 +3,6 @@
 #include <cctype>
 #include <algorithm>
 #include <utility>
-#include <set>
 #include <array>
 #include "scanner.h"
 
@@ -73,74 +72,14 @@ const std::string &ScanningFailure::what() const { return message; }
 
 /* Representation of a DFA, used to handle the scanning process.
  */
-class AsmDFA {
-  public:
-    enum State {
-      // States that are also kinds
-      ID = 0,
-      LABEL,
-      COMMA,
-      LPAREN,
-      RPAREN,
-      INT,
-      HEXINT,
-      REG,
-      WHITESPACE,
-      COMMENT,
-
-      // States that are not also kinds
-      FAIL,
-      START,
-      DOT,
-      DOTID,
-      ZERO,
-      ZEROX,
-      MINUS,
-      DOLLARS,
-
-      // Hack to let this be used easily in arrays. This should always be the
-      // final element in the enum, and should always point to the previous
-      // element.
-
-      LARGEST_STATE = DOLLARS
-    };
-
+class AsmDFA : public ScannerStates {
   private:
-    /* A set of all accepting states for the DFA.
-     * Currently non-accepting states are not actually present anywhere
-     * in memory, but a list can be found in the constructor.
-     */
-    std::set<State> acceptingStates;
-
     /*
      * The transition function for the DFA, stored as a map.
      */
 
     std::array<std::array<State, 128>, LARGEST_STATE + 1> transitionFunction;
 
-    /*
-     * Converts a state to a kind to allow construction of Tokens from States.
-     * Throws an exception if conversion is not possible.
-     */
-    Token::Kind stateToKind(State s) const {
-      switch(s) {
-        case ID:         return Token::ID;
-        case LABEL:      return Token::LABEL;
-        case DOTID:      return Token::WORD;
-        case COMMA:      return Token::COMMA;
-        case LPAREN:     return Token::LPAREN;
-        case RPAREN:     return Token::RPAREN;
-        case INT:        return Token::INT;
-        case ZERO:       return Token::INT;
-        case HEXINT:     return Token::HEXINT;
-        case REG:        return Token::REG;
-        case WHITESPACE: return Token::WHITESPACE;
-        case COMMENT:    return Token::COMMENT;
-        default: throw ScanningFailure("ERROR: Cannot convert state to kind.");
-      }
-    }
-
-
   public:
     /* Tokenizes an input string according to the Simplified Maximal Munch
      * scanning algorithm.
@@ -185,14 +124,9 @@ class AsmDFA {
       return result;
     }
 
-    /* Initializes the accepting states for the DFA.
+    /* Initializes the transitions for the DFA.
      */
     AsmDFA() {
-      acceptingStates = {ID, LABEL, DOTID, HEXINT,
-                           INT, ZERO, COMMA, REG,
-                           LPAREN, RPAREN, WHITESPACE, COMMENT};
-      //Non-accepting states are DOT, MINUS, ZEROX, DOLLARS, START
-
       // Initialize transitions for the DFA
       for (size_t i = 0; i < transitionFunction.size(); ++i) {
         for (size_t j = 0; j < transitionFunction[0].size(); ++j) {
@@ -261,18 +195,14 @@ class AsmDFA {
      */
     bool failed(State state) const { return state == FAIL; }
 
-    /* Checks whether the state returned by transition
-     * is an accepting state.
-     */
-    bool accept(State state) const {
-      return acceptingStates.count(state) > 0;
-    }
-
     /* Returns the starting state of the DFA
      */
     State start() const { return START; }
 };
 
+constexpr uint64_t ScannerStates::acceptingStates;
+constexpr Token::Kind ScannerStates::stateKinds[];
+
 std::vector<Token> scan(const std::string &input) {
   static AsmDFA theDFA;
 
@@ -120,3 +120,93 @@ class ScanningFailure {
     // Returns the message associated with the exception.
     const std::string &what() const;
 };
+
+/* The states of the scanner's DFA, whose transitions are built in
+ * scanner.cc, and the check made each time a token ends: whether the state
+ * the munch stopped in is accepting, and which kind of token it makes.
+ */
+class ScannerStates {
+  public:
+    enum State {
+      // States that are also kinds
+      ID = 0,
+      LABEL,
+      COMMA,
+      LPAREN,
+      RPAREN,
+      INT,
+      HEXINT,
+      REG,
+      WHITESPACE,
+      COMMENT,
+
+      // States that are not also kinds
+      FAIL,
+      START,
+      DOT,
+      DOTID,
+      ZERO,
+      ZEROX,
+      MINUS,
+      DOLLARS,
+
+      // Hack to let this be used easily in arrays. This should always be the
+      // final element in the enum, and should always point to the previous
+      // element.
+
+      LARGEST_STATE = DOLLARS
+    };
+
+    /* The accepting states for the DFA, one bit per state, so checking
+     * acceptance at a token boundary is a single shift and mask.
+     */
+    static constexpr uint64_t acceptingStates =
+      1ull << ID | 1ull << LABEL | 1ull << DOTID | 1ull << HEXINT |
+      1ull << INT | 1ull << ZERO | 1ull << COMMA | 1ull << REG |
+      1ull << LPAREN | 1ull << RPAREN | 1ull << WHITESPACE | 1ull << COMMENT;
+    //Non-accepting states are DOT, MINUS, ZEROX, DOLLARS, START
+
+    static_assert(LARGEST_STATE < 64, "acceptingStates needs one bit per state");
+
+    /* The kind of token produced by each state, indexed by state.
+     * Entries for non-accepting states are never read.
+     */
+    static constexpr Token::Kind stateKinds[] = {
+      Token::ID,         // ID
+      Token::LABEL,      // LABEL
+      Token::COMMA,      // COMMA
+      Token::LPAREN,     // LPAREN
+      Token::RPAREN,     // RPAREN
+      Token::INT,        // INT
+      Token::HEXINT,     // HEXINT
+      Token::REG,        // REG
+      Token::WHITESPACE, // WHITESPACE
+      Token::COMMENT,    // COMMENT
+      Token::ID,         // FAIL (non-accepting)
+      Token::ID,         // START (non-accepting)
+      Token::ID,         // DOT (non-accepting)
+      Token::WORD,       // DOTID
+      Token::INT,        // ZERO
+      Token::ID,         // ZEROX (non-accepting)
+      Token::ID,         // MINUS (non-accepting)
+      Token::ID          // DOLLARS (non-accepting)
+    };
+
+    static_assert(sizeof(stateKinds) / sizeof(stateKinds[0]) == LARGEST_STATE + 1,
+                  "stateKinds needs one entry per state");
+
+    /* Checks whether the state returned by transition
+     * is an accepting state.
+     */
+    static constexpr bool accept(State state) {
+      return acceptingStates >> state & 1;
+    }
+
+    /*
+     * Converts an accepting state to a kind to allow construction of Tokens
+     * from States.
+     */
+    static constexpr Token::Kind stateToKind(State s) {
+      return stateKinds[s];
+    }
+};
@@ -0,0 +1,44 @@
+#ifndef CS241_INTERN_H
+#define CS241_INTERN_H
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+/* Interning table for identifiers, shared by wlp4scan, wlp4parse and wlp4gen.
+ * Each distinct identifier gets a dense integer id, in order of first
+ * appearance, so later stages can index arrays by id instead of looking
+ * names up in maps.
+ *
+ * The ids survive the binary formats: the binary token stream (tokenstream.h)
+ * stores each ID token's id, and the binary parse tree (a6/A6P5/treefile.h)
+ * lists the identifiers by id and stores the id in each ID leaf, so wlp4gen
+ * --binary uses the scanner's ids as they are. The text formats carry only
+ * the names; since ids are handed out in order of first appearance, a stage
+ * that interns the names in token order (wlp4parse) or in the preorder of the
+ * tree, which visits the ID leaves in source order (wlp4gen), gets the same
+ * ids back.
+ */
+class InternTable {
+    std::unordered_map<std::string, int> ids;
+    std::vector<std::string> names;
+
+  public:
+    // Returns the id of s, assigning the next id if s is new
+    int intern(const std::string &s) {
+      auto it = ids.emplace(s, names.size()).first;
+      if (it->second == static_cast<int>(names.size())) {
+        names.push_back(s);
+      }
+      return it->second;
+    }
+
+    // Returns the id of s, or -1 if s has not been interned
+    int lookup(const std::string &s) const {
+      auto it = ids.find(s);
+      return it == ids.end() ? -1 : it->second;
+    }
+
+    const std::string &name(int id) const { return names[id]; }
+    int size() const { return names.size(); }
+};
+#endif
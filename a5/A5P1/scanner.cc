@@ -3,8 +3,12 @@
 #include <cctype>
 #include <algorithm>
 #include <utility>
-#include <set>
 #include <array>
+#include <atomic>
+#include <thread>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "scanner.h"
 
 // wlp4 language scanner based on the asm scanner starter code provided in A3
@@ -13,10 +17,20 @@
 const int64_t MAX = 2147483647;
 
 Token::Token(Token::Kind kind, std::string lexeme):
-  kind(kind), lexeme(std::move(lexeme)) {}
+  kind(kind), lexeme(std::move(lexeme)) {
+  if (kind == NUM) {
+    std::istringstream iss{this->lexeme};
+    iss >> value;
+  }
+}
+
+Token::Token(Token::Kind kind, const char *first, const char *last, int64_t value):
+  kind(kind), lexeme(first, last), value(value) {}
 
   Token:: Kind Token::getKind() const { return kind; }
 const std::string &Token::getLexeme() const { return lexeme; }
+int Token::getId() const { return id; }
+void Token::setId(int id) { this->id = id; }
 
 std::ostream &operator<<(std::ostream &out, const Token &tok) {
   switch (tok.getKind()) {
@@ -61,18 +75,11 @@ std::ostream &operator<<(std::ostream &out, const Token &tok) {
 }
 
 int64_t Token::toNumber() const {
-  std::istringstream iss;
-  int64_t result;
-
   if (kind == NUM) {
-    iss.str(lexeme);
-  } else {
-    // This should never happen if the user calls this function correctly
-    return 0;
+    return value;
   }
-
-  iss >> result;
-  return result;
+  // This should never happen if the user calls this function correctly
+  return 0;
 }
 
 ScanningFailure::ScanningFailure(std::string message):
@@ -80,99 +87,73 @@ ScanningFailure::ScanningFailure(std::string message):
 
 const std::string &ScanningFailure::what() const { return message; }
 
-/* Representation of a DFA, used to handle the scanning process.
+/* Keywords are scanned by the generic ID state and then looked up here.
+ * keywordHash is a perfect hash over the WLP4 keywords: makeKeywordTable
+ * refuses to compile if two of them ever land in the same slot.
  */
-class AsmDFA {
-  public:
-    enum State {
-      // States that are also kinds
-      ID = 0,
-      NUM,
-      LPAREN,
-      RPAREN,
-      LBRACE,
-      RBRACE,
-      RETURN,
-      IF,
-      ELSE,
-      WHILE,
-      PRINTLN,
-      WAIN,
-      BECOMES,
-      INT,
-      EQ,
-      NE,
-      LT,
-      GT,
-      LE,
-      GE,
-      PLUS,
-      MINUS,
-      STAR,
-      SLASH,
-      PCT,
-      COMMA,
-      SEMI,
-      NEW,
-      DELETE,
-      LBRACK,
-      RBRACK,
-      AMP,
-      NUL,
-      WHITESPACE,
-      COMMENT,
-
-      // States that are not also kinds
-      FAIL,
-      START,
-      xW,
-      xWA,
-      xWAI,
-      xWH,
-      xWHI,
-      xWHIL,
-      xI,
-      xIN,
-      xE,
-      xEL,
-      xELS,
-      xP,
-      xPR,
-      xPRI,
-      xPRIN,
-      xPRINT,
-      xPRINTL,
-      xR,
-      xRE,
-      xRET,
-      xRETU,
-      xRETUR,
-      xCapN,
-      xCapNU,
-      xCapNUL,
-      xN,
-      xNE,
-      xD,
-      xDE,
-      xDEL,
-      xDELE,
-      xDELET,
-      ZERO,
-      EXCLAIM,
-
-      // Hack to let this be used easily in arrays. This should always be the
-      // final element in the enum, and should always point to the previous
-      // element.
-
-      LARGEST_STATE = EXCLAIM
-    };
+struct Keyword {
+  const char *text;
+  size_t length;
+  Token::Kind kind;
+};
+
+constexpr Keyword keywords[] = {
+  {"wain", 4, Token::WAIN},
+  {"int", 3, Token::INT},
+  {"if", 2, Token::IF},
+  {"else", 4, Token::ELSE},
+  {"while", 5, Token::WHILE},
+  {"println", 7, Token::PRINTLN},
+  {"return", 6, Token::RETURN},
+  {"new", 3, Token::NEW},
+  {"delete", 6, Token::DELETE},
+  {"NULL", 4, Token::NUL}
+};
+
+const size_t KEYWORD_SLOTS = 16;
+
+constexpr size_t keywordHash(const char *text, size_t length) {
+  return (4 * static_cast<unsigned char>(text[length - 1]) + 3 * length) % KEYWORD_SLOTS;
+}
+
+struct KeywordTable {
+  Keyword slots[KEYWORD_SLOTS];
+};
 
+constexpr KeywordTable makeKeywordTable() {
+  KeywordTable table{};
+  for (const Keyword &k : keywords) {
+    size_t slot = keywordHash(k.text, k.length);
+    if (table.slots[slot].length != 0) {
+      throw "keywordHash is not perfect over the keyword list";
+    }
+    table.slots[slot] = k;
+  }
+  return table;
+}
+
+constexpr KeywordTable keywordTable = makeKeywordTable();
+
+// Returns the keyword kind of the identifier [first, first + length),
+// or Token::ID if it is not a keyword.
+Token::Kind keywordKind(const char *first, size_t length) {
+  const Keyword &k = keywordTable.slots[keywordHash(first, length)];
+  if (k.length == length && std::equal(first, first + length, k.text)) {
+    return k.kind;
+  }
+  return Token::ID;
+}
+
+/* Representation of a DFA, used to handle the scanning process.
+ */
+class AsmDFA : public ScannerStates {
   private:
-    /* A set of all accepting states for the DFA.
-     * Currently non-accepting states are not actually present anywhere
-     * in memory, but a list can be found in the constructor.
+    /* The states that loop back to themselves on a whole character class,
+     * whose runs skipRun consumes in one step.
      */
-    std::set<State> acceptingStates;
+    static constexpr uint64_t runStates =
+      1ull << ID | 1ull << NUM | 1ull << WHITESPACE | 1ull << COMMENT;
+
 
     /*
      * The transition function for the DFA, stored as a map.
@@ -180,140 +161,85 @@ class AsmDFA {
 
     std::array<std::array<State, 128>, LARGEST_STATE + 1> transitionFunction;
 
-    /*
-     * Converts a state to a kind to allow construction of Tokens from States.
-     * Throws an exception if conversion is not possible.
-     */
-    Token::Kind stateToKind(State s) const {
-      switch(s) {
-        case ID:	return Token::ID;
-        case NUM:	return Token::NUM;
-	case LPAREN:	return Token::LPAREN;
-	case RPAREN:	return Token::RPAREN;
-	case LBRACE:	return Token::LBRACE;
-        case RBRACE:    return Token::RBRACE;
-        case RETURN:    return Token::RETURN;
-	case IF:	return Token::IF;
-        case ELSE:      return Token::ELSE;
-        case WHILE:	return Token::WHILE;
-        case PRINTLN:	return Token::PRINTLN;
-        case WAIN:    	return Token::WAIN;
-	case BECOMES:	return Token::BECOMES;
-	case INT:	return Token::INT;
-	case EQ:	return Token::EQ;
-	case NE:	return Token::NE;
-	case LT:	return Token::LT;
-	case GT:	return Token::GT;
-	case LE:	return Token::LE;
-	case GE:	return Token::GE;
-	case PLUS:	return Token::PLUS;
-	case MINUS:	return Token::MINUS;
-	case STAR:	return Token::STAR;
-	case SLASH:	return Token::SLASH;
-	case PCT:	return Token::PCT;
-	case COMMA:	return Token::COMMA;
-	case SEMI:	return Token::SEMI;
-	case NEW:	return Token::NEW;
-	case DELETE:	return Token::DELETE;
-	case LBRACK:	return Token::LBRACK;
-	case RBRACK:	return Token::RBRACK;
-	case AMP:	return Token::AMP;
-	case NUL:	return Token::NUL;
-	case WHITESPACE:	return Token::WHITESPACE;
-	case COMMENT:	return Token::COMMENT;
-	case xW:	return Token::ID;
-	case xWA:	return Token::ID;
-	case xWAI:	return Token::ID;
-	case xWH:	return Token::ID;
-	case xWHI:	return Token::ID;
-	case xWHIL:	return Token::ID;
-	case xI:	return Token::ID;
-	case xIN:	return Token::ID;
-	case xE:	return Token::ID;
-	case xEL:	return Token::ID;
-	case xELS:	return Token::ID;
-	case xP:	return Token::ID;
-	case xPR:	return Token::ID;
-	case xPRI:	return Token::ID;
-	case xPRIN:	return Token::ID;
-	case xPRINT:	return Token::ID;
-	case xPRINTL:	return Token::ID;
-	case xR:	return Token::ID;
-	case xRE:	return Token::ID;
-	case xRET:	return Token::ID;
-	case xRETU:	return Token::ID;
-	case xRETUR:	return Token::ID;
-	case xCapN:	return Token::ID;
-	case xCapNU:	return Token::ID;
-	case xCapNUL:	return Token::ID;
-	case xN:	return Token::ID;
-	case xNE:	return Token::ID;
-	case xD:	return Token::ID;
-	case xDE:	return Token::ID;
-	case xDEL:	return Token::ID;
-	case xDELE:	return Token::ID;
-	case xDELET:	return Token::ID;
-      	case ZERO:	return Token::NUM;
-        default: throw ScanningFailure("ERROR: Cannot convert state to kind.");
-      }
-    }
-
-
   public:
     /* Tokenizes an input string according to the Simplified Maximal Munch
-     * scanning algorithm.
+     * scanning algorithm. WHITESPACE and COMMENT tokens are dropped as soon
+     * as they are recognized, and the value of each NUM token is accumulated
+     * while it is munched. A NUM greater than MAX throws, but only once the
+     * whole input has munched successfully, so munch errors take precedence.
      */
-    std::vector<Token> simplifiedMaximalMunch(const std::string &input) const {
+    std::vector<Token> simplifiedMaximalMunch(const char *inputBegin, const char *inputEnd) const {
       std::vector<Token> result;
 
       State state = start();
-      std::string munchedInput;
+
+      // The lexeme being munched is always the range [tokenStart, inputPosn)
+      // of the input, so nothing is copied until a token is accepted.
+      const char *tokenStart = inputBegin;
+
+      // Value of the NUM being munched, which stops growing once it exceeds MAX
+      int64_t value = 0;
+      bool outOfRange = false;
 
       // We can't use a range-based for loop effectively here
-      // since the iterator doesn't always increment.
-      for (std::string::const_iterator inputPosn = input.begin();
-           inputPosn != input.end();) {
+      // since the pointer doesn't always increment.
+      for (const char *inputPosn = tokenStart; inputPosn != inputEnd;) {
 
         State oldState = state;
         state = transition(state, *inputPosn);
 
         if (!failed(state)) {
-          munchedInput += *inputPosn;
+          // In a state that loops on a character class, consume the whole
+          // run at once; the transition out of it happens next iteration.
+          const char *next = inputPosn + 1;
+          if (runStates >> state & 1) {
+            next = skipRun(state, next, inputEnd);
+          }
+          if (state == NUM) {
+            for (; inputPosn != next && value <= MAX; ++inputPosn) {
+              value = value * 10 + (*inputPosn - '0');
+            }
+          }
           oldState = state;
 
-          ++inputPosn;
+          inputPosn = next;
         }
 
-        if (inputPosn == input.end() || failed(state)) {
+        if (inputPosn == inputEnd || failed(state)) {
           if (accept(oldState)) {
-            result.push_back(Token(stateToKind(oldState), munchedInput));
+            Token::Kind kind = stateToKind(oldState);
+            if (kind == Token::ID) {
+              kind = keywordKind(tokenStart, inputPosn - tokenStart);
+            } else if (kind == Token::NUM && value > MAX) {
+              outOfRange = true;
+            }
+            if (kind != Token::WHITESPACE && kind != Token::COMMENT) {
+              result.emplace_back(kind, tokenStart, inputPosn, value);
+            }
 
-            munchedInput = "";
+            tokenStart = inputPosn;
+            value = 0;
             state = start();
           } else {
             if (failed(state)) {
-              munchedInput += *inputPosn;
+              ++inputPosn;
             }
             throw ScanningFailure("ERROR: Simplified maximal munch failed on input: "
-                                 + munchedInput);
+                                 + std::string(tokenStart, inputPosn));
           }
         }
       }
 
+      if (outOfRange) {
+        throw ScanningFailure("ERROR: Numeric literal out of range");
+      }
+
       return result;
     }
 
-    /* Initializes the accepting states for the DFA.
+    /* Initializes the transitions for the DFA.
      */
     AsmDFA() {
-      acceptingStates = {ID, NUM, LPAREN, RPAREN, LBRACE, RBRACE, RETURN, IF, ELSE, WHILE, PRINTLN,
-      			 WAIN, BECOMES, INT, EQ, NE, LT, GT, LE, GE, PLUS, MINUS, STAR, SLASH,
-      			 PCT, COMMA, SEMI, NEW, DELETE, LBRACK, RBRACK, AMP, NUL, WHITESPACE,
-      			 COMMENT, xW, xWA, xWAI, xWH, xWHI, xWHIL, xI, xIN, xE, xEL, xELS, xP, xPR,
-			 xPRI, xPRIN, xPRINT, xPRINTL, xR, xRE, xRET, xRETU, xRETUR, xCapN, xCapNU, 
-			 xCapNUL, xN, xNE, xD, xDE, xDEL, xDELE, xDELET, ZERO, };
-      //All other states are non-accepting
-
       // Initialize transitions for the DFA
       for (size_t i = 0; i < transitionFunction.size(); ++i) {
         for (size_t j = 0; j < transitionFunction[0].size(); ++j) {
@@ -321,8 +247,8 @@ class AsmDFA {
         }
       }
 
-      // ID Tokens
-      registerTransition(START, "abcfghjklmoqstuvxyzABCDEFGHIJKLMOPQRSTUVWXYZ", ID);
+      // ID Tokens (keywords are scanned as IDs and reclassified by keywordKind)
+      registerTransition(START, isalpha, ID);
       registerTransition(ID, isalnum, ID);
       
       // NUM Tokens
@@ -335,138 +261,6 @@ class AsmDFA {
       registerTransition(START, ")", RPAREN);
       registerTransition(START, "{", LBRACE);
       registerTransition(START, "}", RBRACE);
-      
-      // RETURN Token
-      registerTransition(START, "r", xR);
-      registerTransition(xR, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xR, isdigit, ID);
-      registerTransition(xR, "e", xRE);
-      registerTransition(xRE, "abcdefghijklmnopqrsuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xRE, isdigit, ID);
-      registerTransition(xRE, "t", xRET);
-      registerTransition(xRET, "abcdefghijklmnopqrstvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xRET, isdigit, ID);
-      registerTransition(xRET, "u", xRETU);
-      registerTransition(xRETU, "abcdefghijklmnopqstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xRETU, isdigit, ID);
-      registerTransition(xRETU, "r", xRETUR);
-      registerTransition(xRETUR, "abcedfghijklmopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xRETUR, isdigit, ID);
-      registerTransition(xRETUR, "n", RETURN);
-      registerTransition(RETURN, isalnum, ID);
-      
-      // INT & IF Token
-      registerTransition(START, "i", xI);
-      registerTransition(xI, "abcdeghijklmopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xI, isdigit, ID);
-      registerTransition(xI, "f", IF);
-      registerTransition(xI, "n", xIN);
-      registerTransition(xIN, "abcdefghijklmnopqrsuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xIN, isdigit, ID);
-      registerTransition(xIN, "t", INT);
-      registerTransition(IF, isalnum, ID);
-      registerTransition(INT, isalnum, ID);
-
-      // ELSE Token
-      registerTransition(START, "e", xE);
-      registerTransition(xE, "abcdefghijkmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xE, isdigit, ID);
-      registerTransition(xE, "l", xEL);
-      registerTransition(xEL, "abcdefghijklmnopqrtuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xEL, isdigit, ID);
-      registerTransition(xEL, "s", xELS);
-      registerTransition(xELS, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xELS, isdigit, ID);
-      registerTransition(xELS, "e", ELSE);
-      registerTransition(ELSE, isalnum, ID);
-
-      // WAIN & WHILE Tokens
-      registerTransition(START, "w", xW);
-      registerTransition(xW, "bcdefgijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xW, isdigit, ID);
-      registerTransition(xW, "a", xWA);
-      registerTransition(xWA, "abcdefghjklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xWA, isdigit, ID);
-      registerTransition(xWA, "i", xWAI);
-      registerTransition(xWAI, "abcdefghijklmopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xWAI, isdigit, ID);
-      registerTransition(xWAI, "n", WAIN);
-      registerTransition(WAIN, isalnum, ID);
-      registerTransition(xW, "h", xWH);
-      registerTransition(xWH, "abcdefghjklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xWH, isdigit, ID);
-      registerTransition(xWH, "i", xWHI);
-      registerTransition(xWHI, "abcdefghijkmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xWHI, isdigit, ID);
-      registerTransition(xWHI, "l", xWHIL);
-      registerTransition(xWHIL, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xWHIL, isdigit, ID);
-      registerTransition(xWHIL, "e", WHILE);
-      registerTransition(WHILE, isalnum, ID);
-
-      // PRINTLN Token
-      registerTransition(START, "p", xP);
-      registerTransition(xP, "abcdefghijklmnopqstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xP, isdigit, ID);
-      registerTransition(xP, "r", xPR);
-      registerTransition(xPR, "abcdefghjklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xPR, isdigit, ID);
-      registerTransition(xPR, "i", xPRI);
-      registerTransition(xPRI, "abcdefghijklmopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xPRI, isdigit, ID);
-      registerTransition(xPRI, "n", xPRIN);
-      registerTransition(xPRIN, "abcdefghijklmnopqrsuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xPRIN, isdigit, ID);
-      registerTransition(xPRIN, "t", xPRINT);
-      registerTransition(xPRINT, "abcdefghijkmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xPRINT, isdigit, ID);
-      registerTransition(xPRINT, "l", xPRINTL);
-      registerTransition(xPRINTL, "abcdefghijklmopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xPRINTL, isdigit, ID);
-      registerTransition(xPRINTL, "n", PRINTLN);
-      registerTransition(PRINTLN, isalnum, ID);
-
-      // NEW Token
-      registerTransition(START, "n", xN);
-      registerTransition(xN, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xN, isdigit, ID);
-      registerTransition(xN, "e", xNE);
-      registerTransition(xNE, "abcdefghijklmnopqrstuvxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xNE, isdigit, ID);
-      registerTransition(xNE, "w", NEW);
-      registerTransition(NEW, isalnum, ID);
-
-      // DELETE Token
-      registerTransition(START, "d", xD);
-      registerTransition(xD, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xD, isdigit, ID);
-      registerTransition(xD, "e", xDE);
-      registerTransition(xDE, "abcdefghijkmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xDE, isdigit, ID);
-      registerTransition(xDE, "l", xDEL);
-      registerTransition(xDEL, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xDEL, isdigit, ID);
-      registerTransition(xDEL, "e", xDELE);
-      registerTransition(xDELE, "abcdefghijklmnopqrsuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xDELE, isdigit, ID);
-      registerTransition(xDELE, "t", xDELET);
-      registerTransition(xDELET, "abcdfghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ", ID);
-      registerTransition(xDELET, isdigit, ID);
-      registerTransition(xDELET, "e", DELETE);
-      registerTransition(DELETE, isalnum, ID);
-
-      // NULL Token
-      registerTransition(START, "N", xCapN);
-      registerTransition(xCapN, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTVWXYZ", ID);
-      registerTransition(xCapN, isdigit, ID);
-      registerTransition(xCapN, "U", xCapNU);
-      registerTransition(xCapNU, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKMNOPQRSTUVWXYZ", ID);
-      registerTransition(xCapNU, isdigit, ID);
-      registerTransition(xCapNU, "L", xCapNUL);
-      registerTransition(xCapNUL, "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKMNOPQRSTUVWXYZ", ID);
-      registerTransition(xCapNUL, isdigit, ID);
-      registerTransition(xCapNUL, "L", NUL);
-      registerTransition(NUL, isalnum, ID);
 
       // BECOMES & EQ Token
       registerTransition(START, "=", BECOMES);
@@ -532,7 +326,8 @@ class AsmDFA {
      * or a special fail state if the transition does not exist.
      */
     State transition(State state, char nextChar) const {
-      return transitionFunction[state][nextChar];
+      unsigned char c = nextChar;
+      return c < 128 ? transitionFunction[state][c] : FAIL;
     }
 
     /* Checks whether the state returned by transition
@@ -540,40 +335,446 @@ class AsmDFA {
      */
     bool failed(State state) const { return state == FAIL; }
 
-    /* Checks whether the state returned by transition
-     * is an accepting state.
+    /* Returns the starting state of the DFA
      */
-    bool accept(State state) const {
-      return acceptingStates.count(state) > 0;
+    State start() const { return START; }
+
+    /* Returns the end of the run of characters starting at first on which
+     * state, one of runStates, transitions back to itself. With SSE2 the run
+     * is classified 16 bytes at a time; the final partial block, and every
+     * block on targets without SSE2, goes through transition().
+     */
+    const char *skipRun(State state, const char *first, const char *last) const {
+#ifdef __SSE2__
+      while (last - first >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        unsigned mask = runMask(state, block);
+        if (mask != 0xFFFF) {
+          return first + __builtin_ctz(~mask);
+        }
+        first += 16;
+      }
+#endif
+      while (first != last && transition(state, *first) == state) {
+        ++first;
+      }
+      return first;
     }
 
-    /* Returns the starting state of the DFA
+#ifdef __SSE2__
+    // Mask of the bytes in [lo, hi]; bytes >= 128 compare as negative and never match
+    static __m128i inRange(__m128i c, char lo, char hi) {
+      return _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8(lo - 1)),
+                           _mm_cmplt_epi8(c, _mm_set1_epi8(hi + 1)));
+    }
+
+    /* Returns a 16-bit mask of the bytes of c on which state loops, matching
+     * the transitions registered in the constructor (isalnum for ID, isdigit
+     * for NUM, isspace for WHITESPACE, and any ASCII byte but newline for
+     * COMMENT).
      */
-    State start() const { return START; }
+    static unsigned runMask(State state, __m128i c) {
+      __m128i digit = inRange(c, '0', '9');
+      __m128i in;
+      switch (state) {
+        case ID:
+          in = _mm_or_si128(digit, inRange(_mm_or_si128(c, _mm_set1_epi8(0x20)), 'a', 'z'));
+          break;
+        case NUM:
+          in = digit;
+          break;
+        case WHITESPACE:
+          in = _mm_or_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8(' ')), inRange(c, '\t', '\r'));
+          break;
+        default:
+          in = _mm_andnot_si128(_mm_cmpeq_epi8(c, _mm_set1_epi8('\n')),
+                                _mm_cmpgt_epi8(c, _mm_set1_epi8(-1)));
+          break;
+      }
+      return _mm_movemask_epi8(in);
+    }
+#endif
 };
 
-std::vector<Token> scan(const std::string &input) {
-  static AsmDFA theDFA;
+constexpr uint64_t ScannerStates::acceptingStates;
+constexpr uint64_t AsmDFA::runStates;
+constexpr Token::Kind ScannerStates::stateKinds[];
 
-  std::vector<Token> tokens = theDFA.simplifiedMaximalMunch(input);
+// Scans the line [first, last), see scan below
+std::vector<Token> scanLine(const char *first, const char *last) {
+  static AsmDFA theDFA;
 
-  // We need to:
-  // * Throw exceptions when the value in a NUM Token exceeds the limit
-  // * Remove WHITESPACE and COMMENT tokens entirely.
+  // The munch itself throws when the value in a NUM Token exceeds the limit
+  // and removes WHITESPACE and COMMENT tokens entirely.
+  return theDFA.simplifiedMaximalMunch(first, last);
+}
 
-  std::vector<Token> newTokens;
+std::vector<Token> scan(const std::string &input) {
+  return scanLine(input.data(), input.data() + input.size());
+}
 
+std::vector<Token> scan(const std::string &input, InternTable &identifiers) {
+  std::vector<Token> tokens = scan(input);
   for (auto &token : tokens) {
-	 if (token.getKind() == Token::NUM) {
-		 int64_t x = token.toNumber();
-		 if (x > MAX) {
-			 throw ScanningFailure("ERROR: Numeric literal out of range");
-		 }
-	 }
-	 if (token.getKind() != Token::WHITESPACE && token.getKind() != Token::Kind::COMMENT) { 
-		 newTokens.push_back(token);
-	 }
+	  if (token.getKind() == Token::ID) {
+		  token.setId(identifiers.intern(token.getLexeme()));
+	  }
   }
+  return tokens;
+}
 
-  return newTokens;
+// Shards smaller than this are not worth handing to another thread
+const size_t MIN_SHARD_BYTES = 64 * 1024;
+
+// The tokens and identifiers of one shard of a parallel scan
+struct Shard {
+  const char *first;
+  const char *last;
+  std::vector<Token> tokens;
+  InternTable identifiers;
+  bool failed = false;
+  std::string error;
+};
+
+std::vector<Token> scanParallel(const std::string &program, InternTable &identifiers,
+                                unsigned threads) {
+  const char *const programEnd = program.data() + program.size();
+
+  // Split the program into newline-aligned shards, several per thread so
+  // that shards of uneven cost still balance across the pool.
+  size_t shardCount = std::max<size_t>(1, std::min<size_t>(threads * 8,
+                                                           program.size() / MIN_SHARD_BYTES));
+  std::vector<Shard> shards(shardCount);
+  const char *shardStart = program.data();
+  for (size_t i = 0; i < shardCount; ++i) {
+    const char *shardEnd = programEnd;
+    if (i + 1 < shardCount) {
+      shardEnd = std::max(shardStart, program.data() + program.size() * (i + 1) / shardCount);
+      shardEnd = std::find(shardEnd, programEnd, '\n');
+      if (shardEnd != programEnd) {
+        ++shardEnd;
+      }
+    }
+    shards[i].first = shardStart;
+    shards[i].last = shardEnd;
+    shardStart = shardEnd;
+  }
+
+  // Each worker takes the next unscanned shard until there are none left.
+  // Identifiers are interned per shard so that workers share nothing but
+  // the (immutable) DFA.
+  std::atomic<size_t> nextShard{0};
+  auto worker = [&shards, &nextShard]() {
+    for (size_t i = nextShard++; i < shards.size(); i = nextShard++) {
+      Shard &shard = shards[i];
+      try {
+        for (const char *line = shard.first; line != shard.last;) {
+          const char *lineEnd = std::find(line, shard.last, '\n');
+          for (auto &token : scanLine(line, lineEnd)) {
+            if (token.getKind() == Token::ID) {
+              token.setId(shard.identifiers.intern(token.getLexeme()));
+            }
+            shard.tokens.push_back(std::move(token));
+          }
+          line = lineEnd == shard.last ? lineEnd : lineEnd + 1;
+        }
+      } catch (ScanningFailure &f) {
+        shard.failed = true;
+        shard.error = f.what();
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (unsigned t = 1; t < threads && t < shardCount; ++t) {
+    pool.emplace_back(worker);
+  }
+  worker();
+  for (auto &thread : pool) {
+    thread.join();
+  }
+
+  // Report the same error a line-by-line scan would have hit first
+  for (auto &shard : shards) {
+    if (shard.failed) {
+      throw ScanningFailure(shard.error);
+    }
+  }
+
+  // Concatenate the shards in order. Merging their identifier tables in
+  // shard order gives every identifier the id a line-by-line scan would.
+  size_t total = 0;
+  for (auto &shard : shards) {
+    total += shard.tokens.size();
+  }
+  std::vector<Token> tokens;
+  tokens.reserve(total);
+  std::vector<int> globalIds;
+  for (auto &shard : shards) {
+    globalIds.resize(shard.identifiers.size());
+    for (int i = 0; i < shard.identifiers.size(); ++i) {
+      globalIds[i] = identifiers.intern(shard.identifiers.name(i));
+    }
+    for (auto &token : shard.tokens) {
+      if (token.getKind() == Token::ID) {
+        token.setId(globalIds[token.getId()]);
+      }
+      tokens.push_back(std::move(token));
+    }
+  }
+
+  return tokens;
+}
+
+// Lines per block of an IncrementalScanner. Blocks are kept between
+// BLOCK_LINES / 2 and BLOCK_LINES * 2 lines, unless there is only one.
+const size_t BLOCK_LINES = 256;
+
+IncrementalScanner::Line IncrementalScanner::scanLine(std::string text) {
+  Line line;
+  line.text = std::move(text);
+  try {
+    line.tokens = ::scanLine(line.text.data(), line.text.data() + line.text.size());
+    for (auto &token : line.tokens) {
+      if (token.getKind() == Token::ID) {
+        token.setId(identifierTable.intern(token.getLexeme()));
+      }
+    }
+  } catch (ScanningFailure &f) {
+    line.tokens.clear();
+    line.failed = true;
+    line.error = f.what();
+  }
+  return line;
+}
+
+// Replaces blocks [firstBlock, lastBlock) with evenly sized blocks holding lines
+void IncrementalScanner::replaceLines(size_t firstBlock, size_t lastBlock,
+                                      std::vector<Line> lines) {
+  size_t blockCount = std::max<size_t>(1, (lines.size() + BLOCK_LINES / 2) / BLOCK_LINES);
+  std::vector<Block> newBlocks(blockCount);
+  for (size_t i = 0; i < lines.size(); ++i) {
+    Block &block = newBlocks[i * blockCount / lines.size()];
+    block.chars += lines[i].text.size() + 1;
+    block.tokens += lines[i].tokens.size();
+    block.failures += lines[i].failed;
+    block.lines.push_back(std::move(lines[i]));
+  }
+  blocks.erase(blocks.begin() + firstBlock, blocks.begin() + lastBlock);
+  blocks.insert(blocks.begin() + firstBlock,
+                std::make_move_iterator(newBlocks.begin()),
+                std::make_move_iterator(newBlocks.end()));
+}
+
+// Splits block b if it has grown too big, or merges it with a neighbour if
+// it has shrunk too small
+void IncrementalScanner::rebalance(size_t b) {
+  size_t size = blocks[b].lines.size();
+  if (size > BLOCK_LINES * 2) {
+    replaceLines(b, b + 1, std::move(blocks[b].lines));
+  } else if (size < BLOCK_LINES / 2 && blocks.size() > 1) {
+    size_t first = b + 1 < blocks.size() ? b : b - 1;
+    std::vector<Line> lines = std::move(blocks[first].lines);
+    for (auto &line : blocks[first + 1].lines) {
+      lines.push_back(std::move(line));
+    }
+    replaceLines(first, first + 2, std::move(lines));
+  }
+}
+
+IncrementalScanner::IncrementalScanner(const std::string &text) {
+  std::vector<Line> lines;
+  size_t lineStart = 0;
+  while (true) {
+    size_t lineEnd = text.find('\n', lineStart);
+    if (lineEnd == std::string::npos) {
+      lines.push_back(scanLine(text.substr(lineStart)));
+      break;
+    }
+    lines.push_back(scanLine(text.substr(lineStart, lineEnd - lineStart)));
+    lineStart = lineEnd + 1;
+  }
+  replaceLines(0, 0, std::move(lines));
+}
+
+IncrementalScanner::TokenDiff IncrementalScanner::edit(size_t offset, size_t removedLength,
+                                                        const std::string &inserted) {
+  // Find the block and line holding the start of the edit, and the token
+  // index of that line. Every line counts its newline, except that the
+  // last line of the buffer has none.
+  size_t firstBlock = 0;
+  size_t blockStart = 0;
+  size_t firstToken = 0;
+  while (firstBlock + 1 < blocks.size() && blockStart + blocks[firstBlock].chars <= offset) {
+    blockStart += blocks[firstBlock].chars;
+    firstToken += blocks[firstBlock].tokens;
+    ++firstBlock;
+  }
+  size_t firstLine = 0;
+  size_t lineStart = blockStart;
+  const std::vector<Line> *lines = &blocks[firstBlock].lines;
+  while (firstLine + 1 < lines->size() && lineStart + (*lines)[firstLine].text.size() < offset) {
+    lineStart += (*lines)[firstLine].text.size() + 1;
+    firstToken += (*lines)[firstLine].tokens.size();
+    ++firstLine;
+  }
+  if (offset > lineStart + (*lines)[firstLine].text.size()) {
+    throw ScanningFailure("ERROR: Edit outside of the buffer");
+  }
+  std::string prefix = (*lines)[firstLine].text.substr(0, offset - lineStart);
+
+  // Find the line holding the end of the edit, counting the tokens removed
+  size_t end = offset + removedLength;
+  size_t lastBlock = firstBlock;
+  size_t lastLine = firstLine;
+  size_t removedTokens = 0;
+  while (lineStart + blocks[lastBlock].lines[lastLine].text.size() < end) {
+    const Line &line = blocks[lastBlock].lines[lastLine];
+    lineStart += line.text.size() + 1;
+    removedTokens += line.tokens.size();
+    if (lastLine + 1 < blocks[lastBlock].lines.size()) {
+      ++lastLine;
+    } else if (lastBlock + 1 < blocks.size()) {
+      ++lastBlock;
+      lastLine = 0;
+    } else {
+      throw ScanningFailure("ERROR: Edit outside of the buffer");
+    }
+  }
+  removedTokens += blocks[lastBlock].lines[lastLine].tokens.size();
+  std::string suffix = blocks[lastBlock].lines[lastLine].text.substr(end - lineStart);
+
+  // Rescan the edited text of the affected lines
+  std::string edited = prefix + inserted + suffix;
+  std::vector<Line> newLines;
+  size_t newLineStart = 0;
+  while (true) {
+    size_t newLineEnd = edited.find('\n', newLineStart);
+    if (newLineEnd == std::string::npos) {
+      newLines.push_back(scanLine(edited.substr(newLineStart)));
+      break;
+    }
+    newLines.push_back(scanLine(edited.substr(newLineStart, newLineEnd - newLineStart)));
+    newLineStart = newLineEnd + 1;
+  }
+
+  TokenDiff diff;
+  diff.first = firstToken;
+  diff.removed = removedTokens;
+  for (auto &line : newLines) {
+    diff.inserted.insert(diff.inserted.end(), line.tokens.begin(), line.tokens.end());
+  }
+
+  // Trim the tokens at either end of the diff that did not change
+  std::vector<Token> removed;
+  for (size_t b = firstBlock, l = firstLine; ; ++l) {
+    if (l == blocks[b].lines.size()) {
+      ++b;
+      l = 0;
+    }
+    const Line &line = blocks[b].lines[l];
+    removed.insert(removed.end(), line.tokens.begin(), line.tokens.end());
+    if (b == lastBlock && l == lastLine) {
+      break;
+    }
+  }
+  auto same = [](const Token &a, const Token &b) {
+    return a.getKind() == b.getKind() && a.getLexeme() == b.getLexeme();
+  };
+  size_t common = 0;
+  while (common < removed.size() && common < diff.inserted.size()
+         && same(removed[common], diff.inserted[common])) {
+    ++common;
+  }
+  size_t commonEnd = 0;
+  while (commonEnd < removed.size() - common && commonEnd < diff.inserted.size() - common
+         && same(removed[removed.size() - 1 - commonEnd],
+                 diff.inserted[diff.inserted.size() - 1 - commonEnd])) {
+    ++commonEnd;
+  }
+  diff.first += common;
+  diff.removed -= common + commonEnd;
+  diff.inserted.erase(diff.inserted.end() - commonEnd, diff.inserted.end());
+  diff.inserted.erase(diff.inserted.begin(), diff.inserted.begin() + common);
+
+  // Splice the new lines in place of the old ones. An edit within one block
+  // is patched in place; an edit across blocks regroups the lines left in
+  // them. Either way the block is then rebalanced if it got too big or small.
+  if (firstBlock == lastBlock) {
+    Block &block = blocks[firstBlock];
+    for (size_t l = firstLine; l <= lastLine; ++l) {
+      block.chars -= block.lines[l].text.size() + 1;
+      block.tokens -= block.lines[l].tokens.size();
+      block.failures -= block.lines[l].failed;
+    }
+    for (auto &line : newLines) {
+      block.chars += line.text.size() + 1;
+      block.tokens += line.tokens.size();
+      block.failures += line.failed;
+    }
+    block.lines.erase(block.lines.begin() + firstLine, block.lines.begin() + lastLine + 1);
+    block.lines.insert(block.lines.begin() + firstLine,
+                       std::make_move_iterator(newLines.begin()),
+                       std::make_move_iterator(newLines.end()));
+  } else {
+    std::vector<Line> merged;
+    for (size_t l = 0; l < firstLine; ++l) {
+      merged.push_back(std::move(blocks[firstBlock].lines[l]));
+    }
+    for (auto &line : newLines) {
+      merged.push_back(std::move(line));
+    }
+    for (size_t l = lastLine + 1; l < blocks[lastBlock].lines.size(); ++l) {
+      merged.push_back(std::move(blocks[lastBlock].lines[l]));
+    }
+    replaceLines(firstBlock, lastBlock + 1, std::move(merged));
+  }
+  rebalance(firstBlock);
+
+  return diff;
+}
+
+std::string IncrementalScanner::text() const {
+  std::string result;
+  for (auto &block : blocks) {
+    for (auto &line : block.lines) {
+      result += line.text;
+      result += '\n';
+    }
+  }
+  result.pop_back();
+  return result;
+}
+
+std::vector<Token> IncrementalScanner::tokens() const {
+  std::vector<Token> result;
+  for (auto &block : blocks) {
+    for (auto &line : block.lines) {
+      result.insert(result.end(), line.tokens.begin(), line.tokens.end());
+    }
+  }
+  return result;
 }
+
+size_t IncrementalScanner::tokenCount() const {
+  size_t count = 0;
+  for (auto &block : blocks) {
+    count += block.tokens;
+  }
+  return count;
+}
+
+std::string IncrementalScanner::firstError() const {
+  for (auto &block : blocks) {
+    if (block.failures > 0) {
+      for (auto &line : block.lines) {
+        if (line.failed) {
+          return line.error;
+        }
+      }
+    }
+  }
+  return "";
+}
+
+const InternTable &IncrementalScanner::identifiers() const { return identifierTable; }
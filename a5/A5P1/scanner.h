@@ -5,6 +5,7 @@
 #include <set>
 #include <cstdint>
 #include <ostream>
+#include "intern.h"
 
 // Scanner for wlp4 programming language -> based on the asm scanner starter code provided in A3
 
@@ -14,6 +15,20 @@ class Token;
 
 std::vector<Token> scan(const std::string &input);
 
+// As above, and also interns every identifier in identifiers, storing its id in the ID token.
+
+std::vector<Token> scan(const std::string &input, InternTable &identifiers);
+
+/* Scans a whole program on up to "threads" threads and returns its tokens.
+ * WLP4 tokens never span lines, so the program is split into newline-aligned
+ * shards that are scanned independently and concatenated in order. The result
+ * (tokens, ids and the first error thrown) is the same as calling
+ * scan(line, identifiers) on each line in turn. Requires linking with -pthread.
+ */
+
+std::vector<Token> scanParallel(const std::string &program, InternTable &identifiers,
+                                unsigned threads);
+
 /* A scanned token produced by the scanner.
  * The "kind" tells us what kind of token it is
  * while the "lexeme" tells us exactly what text
@@ -63,13 +78,25 @@ class Token {
   private:
     Kind kind;
     std::string lexeme;
+    int id = -1;
+    int64_t value = 0;
 
   public:
     Token(Kind kind, std::string lexeme);
 
+    // Builds a token whose lexeme is the input range [first, last).
+    // value is the number a NUM token represents, as computed by the scanner.
+    Token(Kind kind, const char *first, const char *last, int64_t value = 0);
+
     Kind getKind() const;
     const std::string &getLexeme() const;
 
+    /* The interned id of an ID token's lexeme, or -1 if
+     * the token was not interned.
+     */
+    int getId() const;
+    void setId(int id);
+
     /* Converts a token to the corresponding number.
      * Only works on tokens of type NUM.
      */
@@ -92,4 +119,190 @@ class ScanningFailure {
     // Returns the message associated with the exception.
     const std::string &what() const;
 };
+
+/* The states of the scanner's DFA, whose transitions are built in
+ * scanner.cc, and the check made each time a token ends: whether the state
+ * the munch stopped in is accepting, and which kind of token it makes.
+ */
+class ScannerStates {
+  public:
+    enum State : unsigned char {
+      // States that are also kinds
+      ID = 0,
+      NUM,
+      LPAREN,
+      RPAREN,
+      LBRACE,
+      RBRACE,
+      BECOMES,
+      EQ,
+      NE,
+      LT,
+      GT,
+      LE,
+      GE,
+      PLUS,
+      MINUS,
+      STAR,
+      SLASH,
+      PCT,
+      COMMA,
+      SEMI,
+      LBRACK,
+      RBRACK,
+      AMP,
+      WHITESPACE,
+      COMMENT,
+
+      // States that are not also kinds
+      FAIL,
+      START,
+      ZERO,
+      EXCLAIM,
+
+      // Hack to let this be used easily in arrays. This should always be the
+      // final element in the enum, and should always point to the previous
+      // element.
+
+      LARGEST_STATE = EXCLAIM
+    };
+
+    /* The accepting states for the DFA, one bit per state, so checking
+     * acceptance at a token boundary is a single shift and mask.
+     */
+    static constexpr uint64_t acceptingStates =
+      1ull << ID | 1ull << NUM | 1ull << LPAREN | 1ull << RPAREN | 1ull << LBRACE |
+      1ull << RBRACE | 1ull << BECOMES | 1ull << EQ | 1ull << NE | 1ull << LT |
+      1ull << GT | 1ull << LE | 1ull << GE | 1ull << PLUS | 1ull << MINUS |
+      1ull << STAR | 1ull << SLASH | 1ull << PCT | 1ull << COMMA | 1ull << SEMI |
+      1ull << LBRACK | 1ull << RBRACK | 1ull << AMP | 1ull << WHITESPACE |
+      1ull << COMMENT | 1ull << ZERO;
+    //All other states are non-accepting
+
+    static_assert(LARGEST_STATE < 64, "acceptingStates needs one bit per state");
+
+    /* The kind of token produced by each state, indexed by state.
+     * Entries for non-accepting states are never read.
+     */
+    static constexpr Token::Kind stateKinds[] = {
+      Token::ID,		// ID
+      Token::NUM,		// NUM
+      Token::LPAREN,		// LPAREN
+      Token::RPAREN,		// RPAREN
+      Token::LBRACE,		// LBRACE
+      Token::RBRACE,		// RBRACE
+      Token::BECOMES,		// BECOMES
+      Token::EQ,		// EQ
+      Token::NE,		// NE
+      Token::LT,		// LT
+      Token::GT,		// GT
+      Token::LE,		// LE
+      Token::GE,		// GE
+      Token::PLUS,		// PLUS
+      Token::MINUS,		// MINUS
+      Token::STAR,		// STAR
+      Token::SLASH,		// SLASH
+      Token::PCT,		// PCT
+      Token::COMMA,		// COMMA
+      Token::SEMI,		// SEMI
+      Token::LBRACK,		// LBRACK
+      Token::RBRACK,		// RBRACK
+      Token::AMP,		// AMP
+      Token::WHITESPACE,	// WHITESPACE
+      Token::COMMENT,		// COMMENT
+      Token::ID,		// FAIL (non-accepting)
+      Token::ID,		// START (non-accepting)
+      Token::NUM,		// ZERO
+      Token::ID			// EXCLAIM (non-accepting)
+    };
+
+    static_assert(sizeof(stateKinds) / sizeof(stateKinds[0]) == LARGEST_STATE + 1,
+                  "stateKinds needs one entry per state");
+
+    /* Checks whether the state returned by transition
+     * is an accepting state.
+     */
+    static constexpr bool accept(State state) {
+      return acceptingStates >> state & 1;
+    }
+
+    /*
+     * Converts an accepting state to a kind to allow construction of Tokens
+     * from States.
+     */
+    static constexpr Token::Kind stateToKind(State s) {
+      return stateKinds[s];
+    }
+};
+
+/* Incremental scanner for a WLP4 buffer that is being edited, e.g. by an
+ * editor integration that would otherwise rescan the whole file after every
+ * keystroke.
+ *
+ * Since tokens never span lines, an edit can only change the tokens of the
+ * lines it touches: the stream resynchronizes at the first line boundary
+ * after the edit. edit() therefore rescans just those lines and reports the
+ * change as a token-level diff. Lines are kept in blocks of a few hundred
+ * with cached character and token counts, so locating an edit costs one
+ * pass over the block counts rather than over the text.
+ *
+ * A line that fails to scan contributes no tokens; its error is kept and
+ * reported by firstError() until the line is edited again. Identifiers are
+ * interned in identifiers(); ids stay stable across edits.
+ */
+class IncrementalScanner {
+  public:
+    /* The tokens [first, first + removed) of the previous token list were
+     * replaced by inserted.
+     */
+    struct TokenDiff {
+      size_t first;
+      size_t removed;
+      std::vector<Token> inserted;
+    };
+
+  private:
+    struct Line {
+      std::string text;
+      std::vector<Token> tokens;
+      bool failed = false;
+      std::string error;
+    };
+
+    struct Block {
+      std::vector<Line> lines;
+      size_t chars = 0;    // characters in the block, counting one newline per line
+      size_t tokens = 0;
+      size_t failures = 0;
+    };
+
+    std::vector<Block> blocks;
+    InternTable identifierTable;
+
+    Line scanLine(std::string text);
+    void replaceLines(size_t firstBlock, size_t lastBlock, std::vector<Line> lines);
+    void rebalance(size_t b);
+
+  public:
+    // Scans the whole of text
+    explicit IncrementalScanner(const std::string &text);
+
+    /* Replaces the removedLength characters at offset with inserted and
+     * returns how the token list changed. Throws ScanningFailure if the
+     * edit does not lie within the buffer.
+     */
+    TokenDiff edit(size_t offset, size_t removedLength, const std::string &inserted);
+
+    // The current contents of the buffer
+    std::string text() const;
+
+    // The current token list (WHITESPACE and COMMENT tokens are dropped, as by scan)
+    std::vector<Token> tokens() const;
+    size_t tokenCount() const;
+
+    // The error of the first line that fails to scan, or an empty string if there is none
+    std::string firstError() const;
+
+    const InternTable &identifiers() const;
+};
 #endif
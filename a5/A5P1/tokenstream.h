@@ -0,0 +1,226 @@
+#ifndef CS241_TOKENSTREAM_H
+#define CS241_TOKENSTREAM_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "scanner.h"
+
+/* Compact binary token stream passed from wlp4scan to wlp4parse as an
+ * alternative to the default "KIND lexeme" text lines.
+ *
+ * Layout (all integers are 32-bit, host byte order):
+ *   char     magic[8]               TOKEN_STREAM_MAGIC
+ *   uint32   tokenCount
+ *   uint32   stringCount
+ *   uint32   stringBytes
+ *   uint32   reserved               always 0
+ *   uint8    kinds[tokenCount]      Token::Kind of each token
+ *                                   (zero padded to a multiple of 4)
+ *   uint32   values[tokenCount]     interned id for ID tokens, the value
+ *                                   for NUM tokens, 0 otherwise
+ *   uint32   stringOffsets[stringCount + 1]
+ *   char     strings[stringBytes]   the identifier with id i is
+ *                                   [stringOffsets[i], stringOffsets[i+1])
+ *
+ * Every other kind has a fixed spelling (tokenKindLexemes) and NUM lexemes
+ * never have leading zeros, so the original lexemes are fully recoverable.
+ * The header is self-contained so that the parser can use it without
+ * linking the scanner.
+ */
+
+const char TOKEN_STREAM_MAGIC[8] = {'\x7f', 'W', 'L', 'P', '4', 'T', 'K', '1'};
+
+// Names of the token kinds as they appear in the text format, indexed by Token::Kind
+const char *const tokenKindNames[] = {
+  "ID", "NUM", "LPAREN", "RPAREN", "LBRACE", "RBRACE", "RETURN", "IF", "ELSE",
+  "WHILE", "PRINTLN", "WAIN", "BECOMES", "INT", "EQ", "NE", "LT", "GT", "LE",
+  "GE", "PLUS", "MINUS", "STAR", "SLASH", "PCT", "COMMA", "SEMI", "NEW",
+  "DELETE", "LBRACK", "RBRACK", "AMP", "NULL", "WHITESPACE", "COMMENT"
+};
+
+// Fixed lexemes of the token kinds, indexed by Token::Kind (empty for ID, NUM, WHITESPACE and COMMENT)
+const char *const tokenKindLexemes[] = {
+  "", "", "(", ")", "{", "}", "return", "if", "else",
+  "while", "println", "wain", "=", "int", "==", "!=", "<", ">", "<=",
+  ">=", "+", "-", "*", "/", "%", ",", ";", "new",
+  "delete", "[", "]", "&", "NULL", "", ""
+};
+
+static_assert(sizeof(tokenKindNames) / sizeof(tokenKindNames[0]) == Token::COMMENT + 1,
+              "tokenKindNames needs one entry per Token::Kind");
+static_assert(sizeof(tokenKindLexemes) / sizeof(tokenKindLexemes[0]) == Token::COMMENT + 1,
+              "tokenKindLexemes needs one entry per Token::Kind");
+
+struct TokenStreamHeader {
+  char magic[8];
+  uint32_t tokenCount;
+  uint32_t stringCount;
+  uint32_t stringBytes;
+  uint32_t reserved;
+};
+
+/* Writes tokens to out in the binary token stream format. Every ID token
+ * must have been interned in identifiers, which becomes the string table.
+ */
+inline void writeTokenStream(std::ostream &out, const std::vector<Token> &tokens,
+                             const InternTable &identifiers) {
+  std::vector<uint8_t> kinds;
+  std::vector<uint32_t> values;
+  std::vector<uint32_t> stringOffsets{0};
+  std::string strings;
+
+  kinds.reserve(tokens.size());
+  values.reserve(tokens.size());
+  for (auto &token : tokens) {
+    kinds.push_back(token.getKind());
+    if (token.getKind() == Token::ID) {
+      values.push_back(token.getId());
+    } else if (token.getKind() == Token::NUM) {
+      values.push_back(token.toNumber());
+    } else {
+      values.push_back(0);
+    }
+  }
+  kinds.resize((kinds.size() + 3) / 4 * 4, 0);
+
+  for (int i = 0; i < identifiers.size(); ++i) {
+    strings += identifiers.name(i);
+    stringOffsets.push_back(strings.size());
+  }
+
+  TokenStreamHeader header;
+  std::memcpy(header.magic, TOKEN_STREAM_MAGIC, sizeof(header.magic));
+  header.tokenCount = tokens.size();
+  header.stringCount = stringOffsets.size() - 1;
+  header.stringBytes = strings.size();
+  header.reserved = 0;
+
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  out.write(reinterpret_cast<const char *>(kinds.data()), kinds.size());
+  out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(uint32_t));
+  out.write(reinterpret_cast<const char *>(stringOffsets.data()),
+            stringOffsets.size() * sizeof(uint32_t));
+  out.write(strings.data(), strings.size());
+}
+
+/* Read-only view of a binary token stream. The stream is memory-mapped
+ * when the file descriptor refers to a regular file, and read into memory
+ * otherwise (for example when it is a pipe).
+ */
+class TokenStream {
+    const char *data = nullptr;
+    size_t size = 0;
+    bool mapped = false;
+    std::string buffer;
+
+    const TokenStreamHeader *header = nullptr;
+    const uint8_t *kinds = nullptr;
+    const uint32_t *values = nullptr;
+    const uint32_t *stringOffsets = nullptr;
+    const char *strings = nullptr;
+
+  public:
+    TokenStream() {}
+    TokenStream(const TokenStream &) = delete;
+    TokenStream &operator=(const TokenStream &) = delete;
+
+    ~TokenStream() {
+      if (mapped) {
+        munmap(const_cast<char *>(data), size);
+      }
+    }
+
+    /* Loads the stream from fd. Returns false with a message in error if
+     * the input is not a well-formed token stream.
+     */
+    bool open(int fd, std::string &error) {
+      struct stat st;
+      if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+          data = static_cast<const char *>(p);
+          size = st.st_size;
+          mapped = true;
+        }
+      }
+      if (!mapped) {
+        char chunk[1 << 16];
+        ssize_t n;
+        while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+          buffer.append(chunk, n);
+        }
+        data = buffer.data();
+        size = buffer.size();
+      }
+
+      if (size < sizeof(TokenStreamHeader)
+          || std::memcmp(data, TOKEN_STREAM_MAGIC, sizeof(TOKEN_STREAM_MAGIC)) != 0) {
+        error = "ERROR: Input is not a binary token stream";
+        return false;
+      }
+      header = reinterpret_cast<const TokenStreamHeader *>(data);
+
+      uint64_t kindBytes = (uint64_t(header->tokenCount) + 3) / 4 * 4;
+      uint64_t expected = sizeof(TokenStreamHeader) + kindBytes
+                          + 4 * uint64_t(header->tokenCount)
+                          + 4 * (uint64_t(header->stringCount) + 1)
+                          + header->stringBytes;
+      if (expected != size) {
+        error = "ERROR: Truncated or corrupt binary token stream";
+        return false;
+      }
+
+      kinds = reinterpret_cast<const uint8_t *>(data + sizeof(TokenStreamHeader));
+      values = reinterpret_cast<const uint32_t *>(kinds + kindBytes);
+      stringOffsets = values + header->tokenCount;
+      strings = reinterpret_cast<const char *>(stringOffsets + header->stringCount + 1);
+
+      if (stringOffsets[0] != 0 || stringOffsets[header->stringCount] != header->stringBytes) {
+        error = "ERROR: Corrupt binary token stream";
+        return false;
+      }
+      for (uint32_t i = 0; i < header->stringCount; ++i) {
+        if (stringOffsets[i] > stringOffsets[i + 1]) {
+          error = "ERROR: Corrupt binary token stream";
+          return false;
+        }
+      }
+      for (uint32_t i = 0; i < header->tokenCount; ++i) {
+        if (kinds[i] > Token::COMMENT
+            || (kinds[i] == Token::ID && values[i] >= header->stringCount)) {
+          error = "ERROR: Corrupt binary token stream";
+          return false;
+        }
+      }
+      return true;
+    }
+
+    size_t tokenCount() const { return header->tokenCount; }
+    Token::Kind kind(size_t i) const { return static_cast<Token::Kind>(kinds[i]); }
+    uint32_t value(size_t i) const { return values[i]; }
+
+    size_t identifierCount() const { return header->stringCount; }
+
+    // Returns the identifier with interned id i
+    std::string identifier(size_t i) const {
+      return std::string(strings + stringOffsets[i], strings + stringOffsets[i + 1]);
+    }
+
+    // Returns the text form of the lexeme of token i
+    std::string lexeme(size_t i) const {
+      switch (kind(i)) {
+        case Token::ID:
+          return identifier(values[i]);
+        case Token::NUM:
+          return std::to_string(values[i]);
+        default:
+          return tokenKindLexemes[kinds[i]];
+      }
+    }
+};
+#endif
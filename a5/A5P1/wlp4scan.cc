@@ -1,18 +1,66 @@
+#include <cctype>
+#include <climits>
+#include <cstdlib>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <vector>
 #include "scanner.h"
+#include "tokenstream.h"
 
 // wlp4 language scanner
+// Usage: wlp4scan [--binary] [--threads N] < foo.wlp4
+// With --binary the tokens are written in the binary token stream format
+// (see tokenstream.h) instead of one "KIND lexeme" line per token.
+// With --threads N the whole program is read first and scanned in
+// newline-aligned shards on N threads (see scanParallel).
+
+int main(int argc, char *argv[]) {
+  bool binary = false;
+  unsigned threads = 0;
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (arg == "--binary") {
+      binary = true;
+    } else if (arg == "--threads" && i + 1 < argc) {
+      const char *value = argv[++i];
+      char *end;
+      unsigned long n = std::strtoul(value, &end, 10);
+      if (!std::isdigit(static_cast<unsigned char>(*value)) || *end != '\0' || n > UINT_MAX) {
+        std::cerr << "ERROR: Bad thread count " << value << std::endl;
+        return 1;
+      }
+      threads = n;
+    } else {
+      std::cerr << "ERROR: Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
 
-int main() {
   std::string line;
   std::vector<std::vector<Token>> program;
+  InternTable identifiers;
   try {
-	  while (getline(std::cin, line)) {
-		  std::vector<Token> tokenLine = scan(line);
-		  program.push_back(tokenLine);
-    
+	  if (threads > 0) {
+		  std::string source{std::istreambuf_iterator<char>(std::cin),
+			  std::istreambuf_iterator<char>()};
+		  program.push_back(scanParallel(source, identifiers, threads));
+	  }
+	  else {
+		  while (getline(std::cin, line)) {
+			  std::vector<Token> tokenLine = scan(line, identifiers);
+			  program.push_back(tokenLine);
+	    
+		  }
+	  }
+
+	  if (binary) {
+		  std::vector<Token> tokens;
+		  for (auto &tokenLine : program) {
+			  tokens.insert(tokens.end(), tokenLine.begin(), tokenLine.end());
+		  }
+		  writeTokenStream(std::cout, tokens, identifiers);
+		  return 0;
 	  }
 	  
 	  for (auto &tokenLine : program) {
@@ -1,37 +1,138 @@
 #include <iostream>
 #include <vector>
-#include <memory>
+#include <string>
+#include <cstdio>
+#include <cstdint>
 
+// A node of the tree; its children are the nodes [first, first + count) of the arena
 class Node {
 	public:
 		int value;
-		std::vector<std::unique_ptr<Node>> children;
+		uint32_t first;
+		uint32_t count;
 
-		Node(int v) : value{v} {}
+		Node(int v) : value{v}, first{0}, count{0} {}
 };
 
-// read pre-order traversal of a tree and construct the tree
-std::unique_ptr<Node> read() {
-	int v, children;
-	std::cin >> v >> children;
-	auto node = std::make_unique<Node>(v);
-	for (int i = 0; i < children; ++i) {
-		node->children.push_back(std::move(read()));
+// Reads all of standard input at once so that parsing doesn't go through operator>>
+class Input {
+		std::vector<char> data;
+		size_t pos = 0;
+
+	public:
+		Input() {
+			char chunk[1 << 16];
+			size_t n;
+			while ((n = fread(chunk, 1, sizeof(chunk), stdin)) > 0) {
+				data.insert(data.end(), chunk, chunk + n);
+			}
+		}
+
+		// function to read the next integer, returns false at the end of input
+		bool next(long long &result) {
+			while (pos < data.size() && (data[pos] == ' ' || data[pos] == '\n' || data[pos] == '\t' || data[pos] == '\r')) {
+				++pos;
+			}
+			bool negative = pos < data.size() && data[pos] == '-';
+			if (negative) {
+				++pos;
+			}
+			if (pos == data.size() || data[pos] < '0' || data[pos] > '9') {
+				return false;
+			}
+			result = 0;
+			while (pos < data.size() && data[pos] >= '0' && data[pos] <= '9') {
+				result = result * 10 + (data[pos] - '0');
+				++pos;
+			}
+			if (negative) {
+				result = -result;
+			}
+			return true;
+		}
+};
+
+// read pre-order traversal of a tree and construct the tree in the arena, returns false if the input ends early
+// The root is nodes[0]. When a node is read, slots for all of its children are reserved at the
+// end of the arena, and the following nodes of the traversal fill them in order.
+bool read(std::vector<Node> &nodes) {
+	Input in;
+	// each entry is the index of the next child slot to fill and the end of that node's child slots
+	std::vector<std::pair<uint32_t, uint32_t>> pending;
+	nodes.emplace_back(0);
+	uint32_t slot = 0;
+	while (true) {
+		long long v, children;
+		if (!in.next(v) || !in.next(children)) {
+			return false;
+		}
+		nodes[slot].value = v;
+		if (children > 0) {
+			uint32_t first = nodes.size();
+			nodes[slot].first = first;
+			nodes[slot].count = children;
+			nodes.resize(first + children, Node{0});
+			pending.emplace_back(first, first + children);
+		}
+		// move to the next unfilled slot, dropping nodes whose children are all read
+		while (!pending.empty() && pending.back().first == pending.back().second) {
+			pending.pop_back();
+		}
+		if (pending.empty()) {
+			return true;
+		}
+		slot = pending.back().first++;
 	}
-	return node;
 }
 
-// print out post-order traversal of tree
-void print(Node *n) {
-	for (std::vector<std::unique_ptr<Node>>::iterator it = n->children.begin(); it != n->children.end(); ++it) {
-		print(it->get());
+// function to append an integer to the output buffer
+void write(std::string &out, long long x) {
+	char digits[24];
+	char *end = digits + sizeof(digits);
+	char *p = end;
+	unsigned long long u = x < 0 ? 0ull - x : x;
+	do {
+		*--p = '0' + u % 10;
+		u /= 10;
+	} while (u != 0);
+	if (x < 0) {
+		*--p = '-';
 	}
-	
-	std::cout << n->value << " " << n->children.size() << std::endl;
+	out.append(p, end);
+}
+
+// print out post-order traversal of tree, buffering the output instead of flushing every line
+void print(const std::vector<Node> &nodes) {
+	std::string out;
+	// each entry is a node and the position of the next of its children to visit
+	std::vector<std::pair<uint32_t, uint32_t>> stack{{0, 0}};
+	while (!stack.empty()) {
+		auto &top = stack.back();
+		const Node &n = nodes[top.first];
+		if (top.second < n.count) {
+			stack.emplace_back(n.first + top.second++, 0);
+			continue;
+		}
+		write(out, n.value);
+		out += ' ';
+		write(out, n.count);
+		out += '\n';
+		if (out.size() >= (1 << 16)) {
+			fwrite(out.data(), 1, out.size(), stdout);
+			out.clear();
+		}
+		stack.pop_back();
+	}
+	fwrite(out.data(), 1, out.size(), stdout);
+	fflush(stdout);
 }
 
 int main() {
-	std::unique_ptr<Node> tree = read();
-	print(tree.get());
+	std::vector<Node> tree;
+	if (!read(tree)) {
+		std::cerr << "ERROR: input ended before the tree was complete" << std::endl;
+		return 1;
+	}
+	print(tree);
 	return 0;
 }
@@ -1,6 +1,7 @@
 #include <iostream>
 #include <string>
 #include <vector>
+#include <unordered_map>
 using std::string;
 using std::istream;
 using std::ostream;
@@ -45,33 +46,90 @@ void skipGrammar(istream &in) {
   }
 }
 
-string trim(const string &str) {
+// remove leading and trailing whitespace from str in place
+void trim(string &str) {
   size_t begin = str.find_first_not_of(" \t\n");
-  if (begin == string::npos) return "";
+  if (begin == string::npos) {
+    str.clear();
+    return;
+  }
 
   size_t end = str.find_last_not_of(" \t\n");
-
-  return str.substr(begin, end - begin + 1);
+  str.erase(end + 1);
+  str.erase(0, begin);
 }
 
-// Prints out result of derivation for a specific CFG
-int printDerivation(istream &in, ostream &out) {
+// The rules the evaluator gives a meaning to; any other line is UNKNOWN and evaluates to 42
+enum Rule { START, EXPR_TERM, TERM_PAREN, EXPR_MINUS, UNKNOWN };
+
+// number of subderivations that follow each rule in the derivation, indexed by Rule
+const int arity[] = {1, 1, 1, 2, 0};
+
+// rule strings, resolved to rule ids once per line instead of compared one by one
+const std::unordered_map<string, Rule> ruleIds = {
+  {"S BOF expr EOF", START},
+  {"expr term", EXPR_TERM},
+  {"term ( expr )", TERM_PAREN},
+  {"expr expr - term", EXPR_MINUS}
+};
+
+// Reads the derivation of the start symbol as a preorder list of rule ids.
+// Lines are read only until the derivation is complete; missing lines at the end of the input are UNKNOWN.
+std::vector<Rule> readDerivation(istream &in) {
+  std::vector<Rule> rules;
   string line;
-  getline(in, line);
-  line = trim(line);
 
-  if (line == "S BOF expr EOF" || line == "expr term" || line == "term ( expr )") {
-	  return printDerivation(in, out);
+  // number of subderivations that still have to be read
+  long needed = 1;
+  while (needed > 0) {
+    Rule rule = UNKNOWN;
+    if (getline(in, line)) {
+      trim(line);
+      auto it = ruleIds.find(line);
+      if (it != ruleIds.end()) {
+        rule = it->second;
+      }
+    }
+    rules.push_back(rule);
+    needed += arity[rule] - 1;
   }
-  else if (line == "expr expr - term") {
-	  return printDerivation(in, out) - printDerivation(in, out);
-  }
-  else {
-	  return 42;
+  return rules;
+}
+
+// Evaluates a derivation given as a preorder list of rule ids.
+// The rules are visited in reverse preorder, so the values of a node's subderivations are already
+// on the stack when the node is reached, with its first subderivation on top.
+int evaluate(const std::vector<Rule> &rules) {
+  std::vector<int> values;
+  for (auto it = rules.rbegin(); it != rules.rend(); ++it) {
+    switch (*it) {
+      case START:
+      case EXPR_TERM:
+      case TERM_PAREN:
+        // the value is that of the only subderivation, already on top
+        break;
+      case EXPR_MINUS: {
+        int left = values.back();
+        values.pop_back();
+        values.back() = left - values.back();
+        break;
+      }
+      default:
+        values.push_back(42);
+        break;
+    }
   }
+  return values.back();
+}
+
+// Prints out result of derivation for a specific CFG
+int printDerivation(istream &in) {
+  return evaluate(readDerivation(in));
 }
 
 int main() {
+  // the derivation is read line by line, so don't synchronize every getline with stdio
+  std::ios::sync_with_stdio(false);
   skipGrammar(std::cin);
-  std::cout << printDerivation(std::cin, std::cout) << std::endl;
+  std::cout << printDerivation(std::cin) << std::endl;
 }
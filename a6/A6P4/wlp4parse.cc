@@ -1,236 +1,124 @@
 #include <utility>
 #include <iostream>
 #include <vector>
-#include <map>
 #include <string>
-#include <sstream>
 #include <algorithm>
 #include <fstream>
+#include "../lrtable.h"
+#include "../lrparse.h"
 using namespace std;
 
-// class representing each node in the parse tree generated by the "Parser" class
-class Node {
-	public:
-		string token;
-		string lexeme;
-		vector<Node> children;
-
-		// constructor
-		Node(string id) : token{id} {}
-};
-
 class Parser {
-	vector<string> terminals;
-	vector<string> nonTerminals;
-	string startSymbol;
-	vector<vector<string>> productionRules;
-	int numStates;
-
-	// shift actions
-	map<pair<int, string>, int> shift;
+	// the grammar symbols (terminals first), the rules, and the parse table as read (see ../lrtable.h)
+	LrGrammar grammar;
 
-	// reduce actions
-	map<pair<int, string>, int> reduce;
+	// ACTION/GOTO entries in the layout chosen by dataRead (see ../lrtable.h)
+	// 0 is an error, s + 1 shifts to (or, for a non-terminal, goes to) state s, and -(r + 1) reduces by rule r
+	LrActions table;
 
 	public:
 
-	void dataRead() {
+	// read the grammar and its parse table from wlp4.cfg, storing the table in layout
+	// returns false, after printing the error, if it can't be read
+	bool dataRead(LrLayout layout) {
 
 		ifstream inp ("wlp4.cfg");
-
-		int counter;	
-	
-		// read and store terminals
-		inp >> counter;
-		string terminal;
-		for (int i = 0; i < counter; ++i) {
-			inp >> terminal;
-			this->terminals.push_back(terminal);
-		}
-
-		// read and store non-terminals
-		inp >> counter;
-		string nonTerminal;
-		for (int i = 0; i < counter; ++i) {
-			inp >> nonTerminal;
-			this->nonTerminals.push_back(nonTerminal);
+		if (!inp) {
+			cerr << "ERROR: Cannot open grammar file wlp4.cfg" << endl;
+			return false;
 		}
-
-		// read and store start symbol
-		inp >> this->startSymbol;
-		
-		// read and store production rules in a vector storing vectors of strings
-                // the first element in each rule vector is the LHS
-                // every element after stores the terminals/non-terminals in the RHS of the rule (as they appear in the rule)
-		inp >> counter;
-		string line;
-		getline(inp, line); // move to next line
-		string symbol;
-		for (int i = 0; i < counter; ++i) {
-			this->productionRules.push_back(vector<string>()); // push back empty vector -> this will store the current rule
-			getline(inp, line);
-			stringstream ss{line};
-			while (ss >> symbol) {
-				this->productionRules[i].push_back(symbol);	
-			}
-		} 
-
-		// read and store number of states
-		inp >> this->numStates;
-
-		// read and store the shift and reduce actions
-		inp >> counter;
-		pair<int, string> p;
-		int move;
-		string check;
-		for (int i = 0; i < counter; ++i) {
-			inp >> p.first; // current state
-			inp >> p.second; // terminal/nonTerminal -> look ahead
-			inp >> check; // check to see if the action is shift or reduce
-			inp >> move; // end state of action
-			if (check == "shift") {
-				this->shift[p] = move;
-			}
-			else if (check == "reduce") {
-				this->reduce[p] = move;
-			}
+		string error;
+		if (!readCfg(inp, grammar, error)) {
+			cerr << error << endl;
+			return false;
 		}
+		this->table = packActions(grammar, layout);
 
 		inp.close();
+		return true;
 	}
 
-
 	void parse() {
-		vector<int> stateStack;
-		vector<Node> symStack;
-		vector<Node> input;
-
-		// create input vector -> manually store BOF and EOF
-		Node b{"BOF"};
-		b.lexeme = "BOF";
-		input.push_back(b);
+		// create input vectors -> manually store BOF and EOF
+		vector<string> input{"BOF"};
+		vector<string> lexemes{"BOF"};
 
 		string id;
 		string lex;
 		while (cin >> id) {
-			Node n{id};
 			cin >> lex;
-			n.lexeme = lex;
-			input.push_back(n);
+			input.push_back(id);
+			lexemes.push_back(lex);
 		}
 
-		Node e("EOF");
-		e.lexeme = "EOF";
-		input.push_back(e);
-
-		stateStack.push_back(0);
-
-		int ruleSize;
-		int readCount = 0;
-
-		// use to check the shift and reduce vectors
-		pair<int, string> check;
-
-		int inputSize = input.size();
+		input.push_back("EOF");
+		lexemes.push_back("EOF");
 
-		for (int i = 0; i < inputSize; ++i) {
-
-			// current input symbol
-			string symbol = input[i].token;
-			
-			for (int rule = reduction(stateStack.back(), symbol); rule != -1; rule = reduction(stateStack.back(), symbol)) {
-				ruleSize = productionRules[rule].size();
-				
-				// initializze a new node with symbol on LHS of production rule
-				Node parent{productionRules[rule][0]};
-				
-				// insert nodes from symStack that are to be popped off as children of arent node
-				parent.children.insert(parent.children.begin(), symStack.end() - ruleSize + 1, symStack.end());
-
-				for (int i = 0; i < ruleSize - 1; ++i) {
-                                        stateStack.pop_back();
-					symStack.pop_back();
-                                }
-
-				// push new node onto symbol stack
-				symStack.push_back(parent);
-
-				check.first = stateStack.back(); 
-				check.second = parent.token;
-				
-				// push next state onto stateStack
-				stateStack.push_back(shift[check]);
-			}
-			
-			// push current symbol on to symStack
-			symStack.push_back(input[i]);
-			
-			check.first = stateStack.back();
-			check.second = symbol;
-			
-			// reject or continue parse
-			if (shift.count(check) == 0) {
-				cerr << "ERROR at " << readCount << endl;
-				return;
-			}
-			else {
-				stateStack.push_back(shift[check]);
-				readCount += 1;
-			}
+		// grammar symbol id of each input token
+		vector<int> tokens;
+		for (auto &token : input) {
+			tokens.push_back(grammar.symbolId(token));
 		}
 
-		// check if reduction on rule 0 is possible
-                if (symStack.size() != productionRules[0].size() - 1) {
-                        cerr << "ERROR at " << readCount + 1 << endl;
-                        return;
-                }
-
-		// final reduction on rule 0
-		Node parent{productionRules[0][0]};
-		parent.children.insert(parent.children.begin(), symStack.begin(), symStack.end());
+		LrTree tree;
+		int readCount = table.visit([&](const auto &actions) {
+			return lrParse(actions, grammar.rules, tree, tokens.data(), tokens.size());
+		});
 
-		// print derivation
-		print(&parent);
+		// reject or print derivation; an error after the last token is counted past it
+		if (readCount != -1) {
+			cerr << "ERROR at " << (readCount < static_cast<int>(tokens.size()) ? readCount : readCount + 1) << endl;
+			return;
+		}
+		print(tree, tree.root(), input, lexemes);
 	}
 
-	// return -1 if no reduction possible
-	// else return the rule used
-	int reduction(int n, string s) {
-		pair<int, string> check (n, s);
-		if (reduce.count(check) == 0) {
-			return -1;
-		}
-		else {
-			return reduce[check];
-		}
+	// name of the symbol with handle h in tree: the LHS of a node, or the input token of a leaf
+	const string &symbolName(const LrTree &tree, int h, const vector<string> &input) const {
+		return h < 0 ? input[~h] : grammar.symbols[grammar.rules.lhs[tree.node(h).rule]];
 	}
 
-	// function to print derivation
-	void print(Node *n) {
-		vector<string>::iterator it;
-		vector<Node>::iterator it2 = n->children.begin();
-		for (; it2 != n->children.end(); ++it2) {
-			string sym = it2->token;
-			it = find (terminals.begin(), terminals.end(), sym);
-			if (sym != "BOF" && sym != "EOF" && it == terminals.end()) {
-				print(&(*it2));
+	// function to print derivation of the symbol with handle h in tree
+	void print(const LrTree &tree, int h, const vector<string> &input, const vector<string> &lexemes) {
+		// an input token named after a non-terminal is a leaf with no children
+		int count = h < 0 ? 0 : tree.node(h).count;
+		for (int i = 0; i < count; ++i) {
+			int child = tree.child(tree.node(h), i);
+			const string &sym = symbolName(tree, child, input);
+			if (sym != "BOF" && sym != "EOF" && !grammar.isTerminal(sym)) {
+				print(tree, child, input, lexemes);
 			}
 			else {
-				cout << sym << " " << it2->lexeme << endl;
+				cout << sym << " " << lexemes[~child] << endl;
 			}
 		}
-		cout << n->token;
-		for (auto &t : n->children) {
-			cout << " " << t.token;
+		cout << symbolName(tree, h, input);
+		for (int i = 0; i < count; ++i) {
+			cout << " " << symbolName(tree, tree.child(tree.node(h), i), input);
 		}
 		cout << endl;
 	}
 };
 
 
-int main() {
+// Usage: wlp4parse [--table dense|comb|map] < foo.scanned
+// The grammar and parse table are read from wlp4.cfg; --table picks their layout (see ../lrtable.h)
+int main(int argc, char *argv[]) {
+	LrLayout layout = LR_DENSE;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--table" && i + 1 < argc && lrLayoutFromName(argv[i + 1], layout)) {
+			++i;
+		}
+		else {
+			cerr << "ERROR: Unknown argument " << arg << endl;
+			return 1;
+		}
+	}
 	Parser p;
-	p.dataRead();
+	if (!p.dataRead(layout)) {
+		return 1;
+	}
 	p.parse();
 	return 0;
 }
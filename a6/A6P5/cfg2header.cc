@@ -0,0 +1,75 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include "../lrtable.h"
+using namespace std;
+
+// Converts a grammar and its LR parse table in the .cfg format read by wlp4parse into a C++ header
+// of constexpr arrays, so that the parser can be compiled with its tables instead of reading them
+// from a file at startup.
+//
+// Usage: cfg2header [prefix] < wlp4.cfg > wlp4table.h
+//
+// Every array and constant in the header is named prefix + name (prefix defaults to "wlp4"):
+//   NumTerminals, NumNonTerminals, NumSymbols   symbol counts
+//   Symbols[]       symbol names, terminals first; the index of a symbol is its id
+//   StartSymbol     id of the start symbol
+//   NumRules, RuleOffsets[], RuleSymbols[]
+//                   rule r is RuleSymbols[RuleOffsets[r], RuleOffsets[r + 1]), LHS first
+//   NumStates, Actions[]
+//                   the ACTION/GOTO table, with the entry for (state, symbol) at
+//                   Actions[state * NumSymbols + symbol]: 0 is an error, s + 1 shifts to
+//                   (or goes to) state s, and -(r + 1) reduces by rule r
+
+// function to print a list of ints, wrapping lines
+void printInts(const vector<int> &v) {
+	for (size_t i = 0; i < v.size(); ++i) {
+		cout << (i % 16 == 0 ? "\n\t" : " ") << v[i] << (i + 1 < v.size() ? "," : "");
+	}
+	cout << "\n";
+}
+
+int main(int argc, char *argv[]) {
+	string prefix = argc > 1 ? argv[1] : "wlp4";
+
+	LrGrammar grammar;
+	string error;
+	if (!readCfg(cin, grammar, error)) {
+		cerr << error << endl;
+		return 1;
+	}
+	int numSymbols = grammar.symbols.size();
+
+	string guard = "CS241_" + prefix + "TABLE_H";
+	for (auto &c : guard) {
+		c = toupper(c);
+	}
+
+	cout << "// Generated by cfg2header -- do not edit.\n";
+	cout << "// Regenerate with: cfg2header " << prefix << " < grammar.cfg > " << prefix << "table.h\n";
+	cout << "#ifndef " << guard << "\n#define " << guard << "\n\n";
+	cout << "constexpr int " << prefix << "NumTerminals = " << grammar.numTerminals << ";\n";
+	cout << "constexpr int " << prefix << "NumNonTerminals = " << numSymbols - grammar.numTerminals << ";\n";
+	cout << "constexpr int " << prefix << "NumSymbols = " << numSymbols << ";\n";
+	cout << "constexpr const char *" << prefix << "Symbols[] = {";
+	for (int i = 0; i < numSymbols; ++i) {
+		cout << (i % 8 == 0 ? "\n\t" : " ") << "\"" << grammar.symbols[i] << "\"" << (i + 1 < numSymbols ? "," : "");
+	}
+	cout << "\n};\n";
+	cout << "constexpr int " << prefix << "StartSymbol = " << grammar.startSymbol << ";\n\n";
+	cout << "constexpr int " << prefix << "NumRules = " << grammar.numRules() << ";\n";
+	cout << "constexpr int " << prefix << "RuleOffsets[] = {";
+	printInts(grammar.ruleOffsets);
+	cout << "};\n";
+	cout << "constexpr int " << prefix << "RuleSymbols[] = {";
+	printInts(grammar.ruleSymbols);
+	cout << "};\n\n";
+	cout << "constexpr int " << prefix << "NumStates = " << grammar.numStates << ";\n";
+	cout << "constexpr int " << prefix << "Actions[] = {";
+	printInts(grammar.actions);
+	cout << "};\n\n";
+	cout << "static_assert(sizeof(" << prefix << "Actions) / sizeof(int) == " << prefix << "NumStates * "
+	     << prefix << "NumSymbols, \"" << prefix << "Actions needs one entry per state and symbol\");\n\n";
+	cout << "#endif\n";
+	return 0;
+}
@@ -0,0 +1,734 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <sstream>
+#include <map>
+#include <deque>
+#include <unordered_map>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include "../lrtable.h"
+using namespace std;
+
+// Builds an LALR(1) (or SLR(1)) parse table for the grammar section of a .cfg or .cfg-r file, so that
+// wlp4.cfg can be regenerated when the grammar changes instead of being written by another tool.
+//
+// Usage: lrgen [--slr|--lalr] [--binary] [--time] [--layouts] < grammar.cfg > table.cfg
+//
+// Only the terminals, non-terminals, start symbol and rules are read; anything after them (an old
+// parse table or a derivation) is ignored. As in wlp4.cfg, rule 0 is the start rule, the parser
+// reduces it itself once the input is shifted, and there is no action for it in the table.
+// The output is the grammar followed by the table in the .cfg format that wlp4parse -g reads, or with
+// --binary the dense table described in ../lrtable.h, which wlp4parse -g also reads. Conflicts are
+// reported on stderr and resolved the way yacc does: a shift beats a reduce, and an earlier rule beats
+// a later one. --time reports how long each phase took on stderr, and --layouts reports the size of the
+// table in each layout the parsers can load it in (see ../lrtable.h), how long it takes to build, and
+// the average time of a lookup, over every non-error entry in a random order.
+
+// a set of terminals, plus two marker bits above them (see Generator)
+class SymbolSet {
+	vector<uint64_t> words;
+
+	public:
+		SymbolSet(int size = 0) : words((size + 63) / 64, 0) {}
+
+		void set(int i) { words[i / 64] |= uint64_t(1) << (i % 64); }
+		void clear() { fill(words.begin(), words.end(), 0); }
+		bool test(int i) const { return words[i / 64] >> (i % 64) & 1; }
+
+		// add every member of other, returns true if this set changed
+		bool merge(const SymbolSet &other) {
+			uint64_t changed = 0;
+			for (size_t w = 0; w < words.size(); ++w) {
+				changed |= other.words[w] & ~words[w];
+				words[w] |= other.words[w];
+			}
+			return changed != 0;
+		}
+
+		// add every member of other except bit skip, returns true if this set changed
+		bool mergeExcept(const SymbolSet &other, int skip) {
+			uint64_t changed = 0;
+			for (size_t w = 0; w < words.size(); ++w) {
+				uint64_t add = other.words[w];
+				if (static_cast<int>(w) == skip / 64) {
+					add &= ~(uint64_t(1) << (skip % 64));
+				}
+				changed |= add & ~words[w];
+				words[w] |= add;
+			}
+			return changed != 0;
+		}
+
+		// call f on each member in increasing order
+		template <typename F> void forEach(F f) const {
+			for (size_t w = 0; w < words.size(); ++w) {
+				for (uint64_t bits = words[w]; bits != 0; bits &= bits - 1) {
+					f(static_cast<int>(w * 64 + __builtin_ctzll(bits)));
+				}
+			}
+		}
+};
+
+class Generator {
+	// the grammar, with symbols numbered terminals first as in wlp4parse
+	vector<string> symbols;
+	unordered_map<string, int> symbolIds;
+	int numTerminals = 0;
+	int startSymbol;
+	vector<string> terminalLines;
+	vector<string> nonTerminalLines;
+	vector<string> ruleLines;
+
+	// rule r is ruleSymbols[ruleOffsets[r], ruleOffsets[r + 1]), LHS first
+	vector<int> ruleOffsets{0};
+	vector<int> ruleSymbols;
+
+	// rules with each non-terminal on the LHS
+	vector<vector<int>> rulesFor;
+
+	// An LR(0) item is a position in ruleSymbols: item i of rule r, for ruleOffsets[r] < i <= ruleOffsets[r + 1],
+	// has its dot just before ruleSymbols[i], and i == ruleOffsets[r + 1] is the complete item. itemRule maps back.
+	vector<int> itemRule;
+
+	// nullable[X] and first[X] for every symbol (a terminal's FIRST is itself)
+	vector<bool> nullable;
+	vector<SymbolSet> first;
+
+	// FIRST of the rest of a rule from position i on, and whether it can derive the empty string
+	vector<SymbolSet> restFirst;
+	vector<bool> restNullable;
+
+	// LR(0) automaton: the sorted kernel items of each state and its transitions as (symbol, state)
+	vector<vector<int>> kernels;
+	vector<vector<pair<int, int>>> transitions;
+
+	// lookaheads of every kernel item, indexed kernelStart[state] + position in kernels[state]
+	vector<int> kernelStart;
+	vector<SymbolSet> lookaheads;
+
+	// Bit numTerminals is the "#" marker used while finding which lookaheads propagate between kernel
+	// items, and bit numTerminals + 1 is the end of input, which only follows the start rule
+	int marker() const { return numTerminals; }
+	int endOfInput() const { return numTerminals + 1; }
+	int setSize() const { return numTerminals + 2; }
+
+	bool isTerminal(int symbol) const { return symbol < numTerminals; }
+
+	// the symbol after the dot of item i, or -1 if the item is complete
+	int nextSymbol(int i) const {
+		return i < ruleOffsets[itemRule[i] + 1] ? ruleSymbols[i] : -1;
+	}
+
+	// function to read a list of symbols preceded by its count, returns false on a short list
+	bool readSymbols(istream &in, vector<string> &lines, bool terminals) {
+		int counter;
+		if (!(in >> counter)) {
+			return false;
+		}
+		string symbol;
+		for (int i = 0; i < counter; ++i) {
+			if (!(in >> symbol)) {
+				return false;
+			}
+			lines.push_back(symbol);
+			// a repeated symbol keeps its first id, as in wlp4parse
+			if (symbolIds.emplace(symbol, symbols.size()).second) {
+				symbols.push_back(symbol);
+				numTerminals += terminals;
+			}
+		}
+		return true;
+	}
+
+	// add the LR(0) closure items of kernel to items; inClosure marks the non-terminals already expanded
+	void closure(const vector<int> &kernel, vector<int> &items, vector<bool> &inClosure) const {
+		items = kernel;
+		for (size_t k = 0; k < items.size(); ++k) {
+			int next = nextSymbol(items[k]);
+			if (next != -1 && !isTerminal(next) && !inClosure[next]) {
+				inClosure[next] = true;
+				for (int r : rulesFor[next]) {
+					items.push_back(ruleOffsets[r] + 1);
+				}
+			}
+		}
+		for (int item : items) {
+			int next = nextSymbol(item);
+			if (next != -1) {
+				inClosure[next] = false;
+			}
+		}
+	}
+
+	/* LR(1) closure of items, where items[k] has the lookaheads itemLookaheads[k]. Every non-kernel
+	 * item of non-terminal X has the same lookaheads, so they are kept once per non-terminal in la[X],
+	 * which is normally empty on entry. Returns the non-terminals reached, with reached[X] set to REACHED;
+	 * those already REACHED on entry are not included. The queue is first in, first out, and holds each non-terminal at
+	 * most once, so that a change to la[X] is passed on in one pass over the symbols below X.
+	 */
+	enum { UNREACHED, REACHED, QUEUED };
+	vector<int> closure1(const vector<int> &items, const vector<SymbolSet> &itemLookaheads, vector<SymbolSet> &la,
+	                     vector<char> &reached) const {
+		vector<int> order;
+		deque<int> work;
+		// function to add FIRST(beta) and, if beta is nullable, follow to the lookaheads of X
+		auto expand = [&](int item, const SymbolSet &follow) {
+			int next = nextSymbol(item);
+			if (next == -1 || isTerminal(next)) {
+				return;
+			}
+			bool changed = la[next].merge(restFirst[item + 1]);
+			if (restNullable[item + 1]) {
+				changed = la[next].merge(follow) || changed;
+			}
+			if (reached[next] == UNREACHED) {
+				order.push_back(next);
+			}
+			if (reached[next] == UNREACHED || (changed && reached[next] == REACHED)) {
+				reached[next] = QUEUED;
+				work.push_back(next);
+			}
+		};
+		for (size_t k = 0; k < items.size(); ++k) {
+			expand(items[k], itemLookaheads[k]);
+		}
+		while (!work.empty()) {
+			int x = work.front();
+			work.pop_front();
+			reached[x] = REACHED;
+			for (int r : rulesFor[x]) {
+				expand(ruleOffsets[r] + 1, la[x]);
+			}
+		}
+		return order;
+	}
+
+	// the state reached from s on symbol, which must exist (transitions are sorted by symbol)
+	int gotoState(int s, int symbol) const {
+		auto &t = transitions[s];
+		return lower_bound(t.begin(), t.end(), make_pair(symbol, 0))->second;
+	}
+
+	// the index in lookaheads of kernel item item of state s
+	int kernelIndex(int s, int item) const {
+		auto &kernel = kernels[s];
+		return kernelStart[s] + (lower_bound(kernel.begin(), kernel.end(), item) - kernel.begin());
+	}
+
+	public:
+		int conflicts = 0;
+
+		// read the grammar section of a .cfg file, returns false with a message on stderr if it is malformed
+		bool read(istream &in) {
+			string start;
+			if (!readSymbols(in, terminalLines, true) || !readSymbols(in, nonTerminalLines, false) || !(in >> start)) {
+				cerr << "ERROR: Truncated grammar" << endl;
+				return false;
+			}
+			auto it = symbolIds.find(start);
+			if (it == symbolIds.end() || isTerminal(it->second)) {
+				cerr << "ERROR: Unknown start symbol " << start << endl;
+				return false;
+			}
+			startSymbol = it->second;
+			rulesFor.assign(symbols.size(), vector<int>());
+
+			int counter;
+			if (!(in >> counter) || counter <= 0) {
+				cerr << "ERROR: Missing rules" << endl;
+				return false;
+			}
+			string line;
+			getline(in, line); // move to next line
+			for (int i = 0; i < counter; ++i) {
+				if (!getline(in, line)) {
+					cerr << "ERROR: Truncated rules" << endl;
+					return false;
+				}
+				stringstream ss{line};
+				string symbol;
+				while (ss >> symbol) {
+					it = symbolIds.find(symbol);
+					if (it == symbolIds.end()) {
+						cerr << "ERROR: Unknown symbol " << symbol << " in rule " << i << endl;
+						return false;
+					}
+					ruleSymbols.push_back(it->second);
+				}
+				int lhs = ruleSymbols.size() == static_cast<size_t>(ruleOffsets.back()) ? -1 : ruleSymbols[ruleOffsets.back()];
+				if (lhs == -1 || isTerminal(lhs)) {
+					cerr << "ERROR: Rule " << i << " does not start with a non-terminal" << endl;
+					return false;
+				}
+				rulesFor[lhs].push_back(i);
+				ruleOffsets.push_back(ruleSymbols.size());
+				ruleLines.push_back(line);
+			}
+			if (ruleSymbols[0] != startSymbol) {
+				cerr << "ERROR: Rule 0 must be a rule for the start symbol" << endl;
+				return false;
+			}
+			itemRule.assign(ruleSymbols.size() + 1, 0);
+			for (size_t r = 0; r + 1 < ruleOffsets.size(); ++r) {
+				for (int i = ruleOffsets[r] + 1; i <= ruleOffsets[r + 1]; ++i) {
+					itemRule[i] = r;
+				}
+			}
+			return true;
+		}
+
+		// compute nullable and FIRST for every symbol and every rest of a rule, iterating to a fixpoint
+		void computeFirst() {
+			nullable.assign(symbols.size(), false);
+			first.assign(symbols.size(), SymbolSet(setSize()));
+			for (int t = 0; t < numTerminals; ++t) {
+				first[t].set(t);
+			}
+			for (bool changed = true; changed;) {
+				changed = false;
+				for (size_t r = 0; r + 1 < ruleOffsets.size(); ++r) {
+					int lhs = ruleSymbols[ruleOffsets[r]];
+					int i = ruleOffsets[r] + 1;
+					for (; i < ruleOffsets[r + 1]; ++i) {
+						changed = first[lhs].merge(first[ruleSymbols[i]]) || changed;
+						if (!nullable[ruleSymbols[i]]) {
+							break;
+						}
+					}
+					if (i == ruleOffsets[r + 1] && !nullable[lhs]) {
+						nullable[lhs] = changed = true;
+					}
+				}
+			}
+
+			restFirst.assign(ruleSymbols.size() + 1, SymbolSet(setSize()));
+			restNullable.assign(ruleSymbols.size() + 1, true);
+			for (size_t r = 0; r + 1 < ruleOffsets.size(); ++r) {
+				for (int i = ruleOffsets[r + 1] - 1; i > ruleOffsets[r]; --i) {
+					int x = ruleSymbols[i];
+					restFirst[i] = first[x];
+					restNullable[i] = nullable[x] && restNullable[i + 1];
+					if (nullable[x]) {
+						restFirst[i].merge(restFirst[i + 1]);
+					}
+				}
+			}
+		}
+
+		// build the LR(0) automaton, numbering states in the order they are found from the start state
+		void buildStates() {
+			map<vector<int>, int> stateIds;
+			vector<int> kernel;
+			for (int r : rulesFor[startSymbol]) {
+				kernel.push_back(ruleOffsets[r] + 1);
+			}
+			stateIds.emplace(kernel, 0);
+			kernels.push_back(kernel);
+
+			vector<int> items;
+			vector<bool> inClosure(symbols.size(), false);
+			// kernel of the successor on each symbol
+			vector<vector<int>> successors(symbols.size());
+			vector<int> used;
+			for (size_t s = 0; s < kernels.size(); ++s) {
+				closure(kernels[s], items, inClosure);
+				for (int item : items) {
+					int next = nextSymbol(item);
+					if (next == -1) {
+						continue;
+					}
+					if (successors[next].empty()) {
+						used.push_back(next);
+					}
+					successors[next].push_back(item + 1);
+				}
+				sort(used.begin(), used.end());
+				transitions.push_back(vector<pair<int, int>>());
+				for (int symbol : used) {
+					auto &next = successors[symbol];
+					sort(next.begin(), next.end());
+					next.erase(unique(next.begin(), next.end()), next.end());
+					auto inserted = stateIds.emplace(next, kernels.size());
+					if (inserted.second) {
+						kernels.push_back(next);
+					}
+					transitions[s].emplace_back(symbol, inserted.first->second);
+					next.clear();
+				}
+				used.clear();
+			}
+
+			kernelStart.push_back(0);
+			for (auto &k : kernels) {
+				kernelStart.push_back(kernelStart.back() + k.size());
+			}
+		}
+
+		// SLR(1): every complete item of X has FOLLOW(X) as its lookaheads
+		void computeFollow(vector<SymbolSet> &follow) {
+			follow.assign(symbols.size(), SymbolSet(setSize()));
+			follow[startSymbol].set(endOfInput());
+			for (bool changed = true; changed;) {
+				changed = false;
+				for (size_t r = 0; r + 1 < ruleOffsets.size(); ++r) {
+					int lhs = ruleSymbols[ruleOffsets[r]];
+					for (int i = ruleOffsets[r] + 1; i < ruleOffsets[r + 1]; ++i) {
+						int x = ruleSymbols[i];
+						if (isTerminal(x)) {
+							continue;
+						}
+						changed = follow[x].merge(restFirst[i + 1]) || changed;
+						if (restNullable[i + 1]) {
+							changed = follow[x].merge(follow[lhs]) || changed;
+						}
+					}
+				}
+			}
+		}
+
+		/* LALR(1) lookaheads by propagation: the closure of each kernel item with lookahead "#" shows
+		 * which lookaheads each successor kernel item gets spontaneously, and which ones it inherits
+		 * from the item (wherever "#" reaches). The inherited ones are then propagated to a fixpoint.
+		 */
+		void computeLookaheads() {
+			lookaheads.assign(kernelStart.back(), SymbolSet(setSize()));
+			vector<vector<int>> propagatesTo(kernelStart.back());
+			for (int r : rulesFor[startSymbol]) {
+				lookaheads[kernelIndex(0, ruleOffsets[r] + 1)].set(endOfInput());
+			}
+
+			/* The closure of [A -> alpha . B beta, #] only depends on B, apart from FIRST(beta) (and "#", if
+			 * beta is nullable) taking the place of "#" in it. So the closure from B with lookahead "#" is
+			 * found once, as (X, lookaheads of the items of X) for each X reached, and reused for every
+			 * kernel item with B after the dot.
+			 */
+			SymbolSet none(setSize());
+			vector<vector<pair<int, SymbolSet>>> closures(symbols.size());
+			vector<bool> cached(symbols.size(), false);
+			vector<SymbolSet> la(symbols.size(), none);
+			vector<char> reached(symbols.size(), UNREACHED);
+			vector<int> items;
+			vector<SymbolSet> hashes;
+			// function to find the closure from non-terminal b
+			auto closureFrom = [&](int b) -> const vector<pair<int, SymbolSet>> & {
+				if (!cached[b]) {
+					cached[b] = true;
+					items.clear();
+					for (int r : rulesFor[b]) {
+						items.push_back(ruleOffsets[r] + 1);
+					}
+					hashes.assign(items.size(), none);
+					for (auto &h : hashes) {
+						h.set(marker());
+					}
+					// b itself has the lookahead "#" and is expanded with it below, so it is not queued
+					la[b].set(marker());
+					reached[b] = REACHED;
+					vector<int> order = closure1(items, hashes, la, reached);
+					order.insert(order.begin(), b);
+					for (int x : order) {
+						closures[b].emplace_back(x, la[x]);
+						la[x] = none;
+						reached[x] = UNREACHED;
+					}
+				}
+				return closures[b];
+			};
+
+			SymbolSet itemLookaheads(setSize());
+			for (size_t s = 0; s < kernels.size(); ++s) {
+				for (size_t k = 0; k < kernels[s].size(); ++k) {
+					int from = kernelStart[s] + k;
+					int kernelItem = kernels[s][k];
+					int b = nextSymbol(kernelItem);
+					if (b == -1) {
+						continue;
+					}
+
+					// function to pass the lookaheads of an item on to its successor's kernel item
+					auto pass = [&](int item, const SymbolSet &on) {
+						int to = kernelIndex(gotoState(s, nextSymbol(item)), item + 1);
+						lookaheads[to].mergeExcept(on, marker());
+						if (on.test(marker())) {
+							propagatesTo[from].push_back(to);
+						}
+					};
+
+					itemLookaheads.clear();
+					itemLookaheads.set(marker());
+					pass(kernelItem, itemLookaheads);
+					if (isTerminal(b)) {
+						continue;
+					}
+					for (auto &reachedFrom : closureFrom(b)) {
+						const SymbolSet &found = reachedFrom.second;
+						itemLookaheads.clear();
+						itemLookaheads.mergeExcept(found, marker());
+						if (found.test(marker())) {
+							itemLookaheads.merge(restFirst[kernelItem + 1]);
+							if (restNullable[kernelItem + 1]) {
+								itemLookaheads.set(marker());
+							}
+						}
+						for (int r : rulesFor[reachedFrom.first]) {
+							if (ruleOffsets[r] + 1 < ruleOffsets[r + 1]) {
+								pass(ruleOffsets[r] + 1, itemLookaheads);
+							}
+						}
+					}
+				}
+			}
+
+			// propagate in rounds, first in first out, with each kernel item queued at most once at a time
+			deque<int> work;
+			vector<bool> queued(kernelStart.back(), true);
+			for (int i = 0; i < kernelStart.back(); ++i) {
+				work.push_back(i);
+			}
+			while (!work.empty()) {
+				int from = work.front();
+				work.pop_front();
+				queued[from] = false;
+				for (int to : propagatesTo[from]) {
+					if (lookaheads[to].merge(lookaheads[from]) && !queued[to]) {
+						queued[to] = true;
+						work.push_back(to);
+					}
+				}
+			}
+		}
+
+		// fill in the dense ACTION/GOTO table, with SLR lookaheads if follow is given
+		void buildTable(LrTable &table, const vector<SymbolSet> *follow) {
+			int numSymbols = symbols.size();
+			table.symbols = symbols;
+			table.numTerminals = numTerminals;
+			table.startSymbol = startSymbol;
+			table.ruleOffsets = ruleOffsets;
+			table.ruleSymbols = ruleSymbols;
+			table.numStates = kernels.size();
+			table.actions.assign(kernels.size() * numSymbols, 0);
+
+			SymbolSet none(setSize());
+			vector<SymbolSet> la(symbols.size(), none);
+			vector<char> reached(symbols.size(), UNREACHED);
+			vector<SymbolSet> kernelLookaheads;
+			for (size_t s = 0; s < kernels.size(); ++s) {
+				int *row = &table.actions[s * numSymbols];
+				for (auto &t : transitions[s]) {
+					row[t.first] = t.second + 1;
+				}
+
+				// function to add the reductions by rule on each lookahead
+				auto reduce = [&](int rule, const SymbolSet &on) {
+					on.forEach([&](int t) {
+						if (t >= numTerminals || rule == 0) {
+							return;
+						}
+						int &entry = row[t];
+						if (entry == 0) {
+							entry = -(rule + 1);
+						}
+						else if (entry != -(rule + 1)) {
+							bool shift = entry > 0;
+							int other = shift ? -1 : -entry - 1;
+							cerr << "WARNING: " << (shift ? "shift/reduce" : "reduce/reduce") << " conflict in state " << s
+							     << " on " << symbols[t] << " between " << (shift ? "shift" : "rule " + to_string(other))
+							     << " and rule " << rule << endl;
+							++conflicts;
+							if (!shift && rule < other) {
+								entry = -(rule + 1);
+							}
+						}
+					});
+				};
+
+				kernelLookaheads.clear();
+				for (size_t k = 0; k < kernels[s].size(); ++k) {
+					int item = kernels[s][k];
+					kernelLookaheads.push_back(follow ? (*follow)[ruleSymbols[ruleOffsets[itemRule[item]]]]
+					                                  : lookaheads[kernelStart[s] + k]);
+					if (nextSymbol(item) == -1) {
+						reduce(itemRule[item], kernelLookaheads.back());
+					}
+				}
+				// the only complete non-kernel items are those of empty rules
+				for (int x : closure1(kernels[s], kernelLookaheads, la, reached)) {
+					for (int r : rulesFor[x]) {
+						if (ruleOffsets[r] + 1 == ruleOffsets[r + 1]) {
+							reduce(r, follow ? (*follow)[x] : la[x]);
+						}
+					}
+					la[x] = none;
+					reached[x] = UNREACHED;
+				}
+			}
+		}
+
+		// print the grammar as it was read, then the table, in the .cfg format
+		void printCfg(const LrTable &table) {
+			ostringstream out;
+			out << terminalLines.size() << "\n";
+			for (auto &s : terminalLines) {
+				out << s << "\n";
+			}
+			out << nonTerminalLines.size() << "\n";
+			for (auto &s : nonTerminalLines) {
+				out << s << "\n";
+			}
+			out << symbols[startSymbol] << "\n";
+			out << ruleLines.size() << "\n";
+			for (auto &s : ruleLines) {
+				out << s << "\n";
+			}
+
+			int numSymbols = symbols.size();
+			int count = 0;
+			for (int a : table.actions) {
+				count += a != 0;
+			}
+			out << table.numStates << "\n" << count << "\n";
+			cout << out.str();
+
+			// the actions are most of the output, so they are formatted into a string directly
+			string lines;
+			for (int s = 0; s < table.numStates; ++s) {
+				string state = to_string(s) + " ";
+				for (int x = 0; x < numSymbols; ++x) {
+					int a = table.actions[s * numSymbols + x];
+					if (a != 0) {
+						lines += state;
+						lines += symbols[x];
+						lines += a > 0 ? " shift " : " reduce ";
+						lines += to_string(a > 0 ? a - 1 : -a - 1);
+						lines += '\n';
+					}
+				}
+				if (lines.size() >= (1 << 16)) {
+					cout << lines;
+					lines.clear();
+				}
+			}
+			cout << lines;
+		}
+};
+
+// the lookups in reportLayout add up their results here, so that they can't be optimized away
+volatile long long lookupSink;
+
+// function to report the size, build time and lookup time of table in each layout
+template <typename Actions>
+void reportLayout(const char *name, const LrTable &table, const vector<pair<int, int>> &lookups,
+                  Actions (*build)(const LrTable &)) {
+	auto start = chrono::steady_clock::now();
+	Actions actions = build(table);
+	auto built = chrono::steady_clock::now();
+	long long sum = 0;
+	for (int rep = 0; rep < 10; ++rep) {
+		for (auto &l : lookups) {
+			sum += actions.action(l.first, l.second);
+		}
+	}
+	auto done = chrono::steady_clock::now();
+	cerr << name << " " << actions.bytes() << " bytes, built in " << chrono::duration<double, milli>(built - start).count()
+	     << " ms, " << chrono::duration<double, nano>(done - built).count() / (10.0 * max<size_t>(1, lookups.size()))
+	     << " ns per lookup" << endl;
+	lookupSink = sum;
+}
+
+int main(int argc, char *argv[]) {
+	bool slr = false;
+	bool binary = false;
+	bool timing = false;
+	bool layouts = false;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--slr" || arg == "--lalr") {
+			slr = arg == "--slr";
+		}
+		else if (arg == "--binary") {
+			binary = true;
+		}
+		else if (arg == "--time") {
+			timing = true;
+		}
+		else if (arg == "--layouts") {
+			layouts = true;
+		}
+		else {
+			cerr << "ERROR: Unknown argument " << arg << endl;
+			return 1;
+		}
+	}
+
+	auto last = chrono::steady_clock::now();
+	// function to report the time since the last phase ended
+	auto phase = [&](const char *name) {
+		auto now = chrono::steady_clock::now();
+		if (timing) {
+			cerr << name << " " << chrono::duration<double, milli>(now - last).count() << " ms" << endl;
+		}
+		last = now;
+	};
+
+	Generator g;
+	if (!g.read(cin)) {
+		return 1;
+	}
+	phase("read");
+	g.computeFirst();
+	phase("first");
+	g.buildStates();
+	phase("states");
+	vector<SymbolSet> follow;
+	if (slr) {
+		g.computeFollow(follow);
+	}
+	else {
+		g.computeLookaheads();
+	}
+	phase("lookaheads");
+	LrTable table;
+	g.buildTable(table, slr ? &follow : nullptr);
+	phase("table");
+	if (binary) {
+		writeLrTable(cout, table);
+	}
+	else {
+		g.printCfg(table);
+	}
+	cout.flush();
+	phase("output");
+	if (timing) {
+		cerr << table.numStates << " states, " << table.symbols.size() << " symbols, " << table.numRules() << " rules, "
+		     << g.conflicts << " conflicts" << endl;
+	}
+	else if (g.conflicts > 0) {
+		cerr << "WARNING: " << g.conflicts << " conflicts" << endl;
+	}
+	if (layouts) {
+		int numSymbols = table.symbols.size();
+		vector<pair<int, int>> lookups;
+		for (int s = 0; s < table.numStates; ++s) {
+			for (int x = 0; x < numSymbols; ++x) {
+				if (table.actions[s * numSymbols + x] != 0) {
+					lookups.emplace_back(s, x);
+				}
+			}
+		}
+		shuffle(lookups.begin(), lookups.end(), mt19937(241));
+		reportLayout<DenseActions>("dense", table, lookups, [](const LrTable &t) {
+			return DenseActions(t.actions, t.numStates, t.symbols.size());
+		});
+		reportLayout<CombActions>("comb", table, lookups, [](const LrTable &t) {
+			return CombActions(t.actions, t.numStates, t.symbols.size(), t.numTerminals);
+		});
+		reportLayout<MapActions>("map", table, lookups, [](const LrTable &t) {
+			return MapActions(t.actions, t.numStates, t.symbols.size());
+		});
+	}
+	return 0;
+}
@@ -0,0 +1,255 @@
+#ifndef CS241_TREEFILE_H
+#define CS241_TREEFILE_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <algorithm>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Compact binary parse tree passed from wlp4parse to wlp4gen (a .wlp4b file,
+ * written by "wlp4parse --binary-tree") as an alternative to the .wlp4i text
+ * listing, where every node repeats its whole production rule.
+ *
+ * Layout (all integers are 32-bit, host byte order):
+ *   char     magic[8]                    TREE_FILE_MAGIC
+ *   uint32   symbolCount, ruleCount, ruleSymbolCount, nodeCount,
+ *            lexemeCount, nameBytes, lexemeBytes, identifierCount
+ *   uint32   nameOffsets[symbolCount + 1]
+ *   uint32   ruleOffsets[ruleCount + 1]
+ *   uint32   ruleSymbols[ruleSymbolCount]
+ *                                        rule r is ruleSymbols[ruleOffsets[r],
+ *                                        ruleOffsets[r + 1]), LHS first
+ *   TreeFileNode nodes[nodeCount]        the tree in preorder
+ *   uint32   lexemeOffsets[lexemeCount + 1]
+ *   char     names[nameBytes]            symbol s is [nameOffsets[s], nameOffsets[s + 1])
+ *   char     lexemes[lexemeBytes]        lexeme i is [lexemeOffsets[i], lexemeOffsets[i + 1])
+ *
+ * A non-terminal node stores its rule id and its number of children, which
+ * follow it. A leaf stores ~symbol (so it is negative) and the index of its
+ * lexeme; each distinct lexeme is stored once. The first identifierCount
+ * lexemes are the program's identifiers, in the order of the ids wlp4scan
+ * interned them with, so the lexeme index of an ID leaf is its identifier's
+ * id; the other lexemes follow in order of first appearance.
+ */
+
+const char TREE_FILE_MAGIC[8] = {'\x7f', 'W', 'L', 'P', '4', 'T', 'R', '2'};
+
+struct TreeFileNode {
+	int32_t rule; // rule id, or ~symbol for a leaf
+	uint32_t value; // number of children, or the lexeme index for a leaf
+};
+
+struct TreeFileHeader {
+	char magic[8];
+	uint32_t symbolCount;
+	uint32_t ruleCount;
+	uint32_t ruleSymbolCount;
+	uint32_t nodeCount;
+	uint32_t lexemeCount;
+	uint32_t nameBytes;
+	uint32_t lexemeBytes;
+	uint32_t identifierCount;
+};
+
+// function to append string table entries: offsets gets the end of each string
+inline void appendStrings(const std::vector<std::string> &strings, std::vector<uint32_t> &offsets, std::string &bytes) {
+	offsets.assign(1, 0);
+	for (auto &s : strings) {
+		bytes += s;
+		offsets.push_back(bytes.size());
+	}
+}
+
+/* Writes a parse tree to out in the binary tree format. nodes is the tree in
+ * preorder, the lexeme of a leaf is lexemes[value], and the identifiers are
+ * lexemes[0, identifierCount).
+ */
+inline void writeTreeFile(std::ostream &out, const std::vector<std::string> &symbols,
+                          const std::vector<uint32_t> &ruleOffsets, const std::vector<uint32_t> &ruleSymbols,
+                          const std::vector<TreeFileNode> &nodes, const std::vector<std::string> &lexemes,
+                          uint32_t identifierCount) {
+	std::vector<uint32_t> nameOffsets;
+	std::vector<uint32_t> lexemeOffsets;
+	std::string names;
+	std::string lexemeBytes;
+	appendStrings(symbols, nameOffsets, names);
+	appendStrings(lexemes, lexemeOffsets, lexemeBytes);
+
+	TreeFileHeader header;
+	std::memcpy(header.magic, TREE_FILE_MAGIC, sizeof(header.magic));
+	header.symbolCount = symbols.size();
+	header.ruleCount = ruleOffsets.size() - 1;
+	header.ruleSymbolCount = ruleSymbols.size();
+	header.nodeCount = nodes.size();
+	header.lexemeCount = lexemes.size();
+	header.nameBytes = names.size();
+	header.lexemeBytes = lexemeBytes.size();
+	header.identifierCount = identifierCount;
+
+	out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char *>(nameOffsets.data()), nameOffsets.size() * sizeof(uint32_t));
+	out.write(reinterpret_cast<const char *>(ruleOffsets.data()), ruleOffsets.size() * sizeof(uint32_t));
+	out.write(reinterpret_cast<const char *>(ruleSymbols.data()), ruleSymbols.size() * sizeof(uint32_t));
+	out.write(reinterpret_cast<const char *>(nodes.data()), nodes.size() * sizeof(TreeFileNode));
+	out.write(reinterpret_cast<const char *>(lexemeOffsets.data()), lexemeOffsets.size() * sizeof(uint32_t));
+	out.write(names.data(), names.size());
+	out.write(lexemeBytes.data(), lexemeBytes.size());
+}
+
+/* Read-only view of a binary parse tree. The file is memory-mapped when the
+ * file descriptor refers to a regular file, and read into memory otherwise
+ * (for example when it is a pipe).
+ */
+class TreeFile {
+	const char *data = nullptr;
+	size_t size = 0;
+	bool mapped = false;
+	std::string buffer;
+
+	const TreeFileHeader *header = nullptr;
+	const uint32_t *nameOffsets = nullptr;
+	const uint32_t *ruleOffsets = nullptr;
+	const uint32_t *ruleSymbols = nullptr;
+	const TreeFileNode *nodes = nullptr;
+	const uint32_t *lexemeOffsets = nullptr;
+	const char *names = nullptr;
+	const char *lexemes = nullptr;
+
+	// function to check that a string table's offsets are in order and end at its size
+	static bool validStrings(const uint32_t *offsets, uint32_t count, uint32_t bytes) {
+		if (offsets[0] != 0 || offsets[count] != bytes) {
+			return false;
+		}
+		for (uint32_t i = 0; i < count; ++i) {
+			if (offsets[i] > offsets[i + 1]) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	public:
+		TreeFile() {}
+		TreeFile(const TreeFile &) = delete;
+		TreeFile &operator=(const TreeFile &) = delete;
+
+		~TreeFile() {
+			if (mapped) {
+				munmap(const_cast<char *>(data), size);
+			}
+		}
+
+		/* Loads the tree from fd. Returns false with a message in error if the
+		 * input is not a well-formed tree, so that readers can walk the nodes
+		 * without any further checks.
+		 */
+		bool open(int fd, std::string &error) {
+			struct stat st;
+			if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+				void *p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+				if (p != MAP_FAILED) {
+					data = static_cast<const char *>(p);
+					size = st.st_size;
+					mapped = true;
+				}
+			}
+			if (!mapped) {
+				char chunk[1 << 16];
+				ssize_t n;
+				while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+					buffer.append(chunk, n);
+				}
+				data = buffer.data();
+				size = buffer.size();
+			}
+
+			if (size < sizeof(TreeFileHeader) || std::memcmp(data, TREE_FILE_MAGIC, sizeof(TREE_FILE_MAGIC)) != 0) {
+				error = "ERROR: Input is not a binary parse tree";
+				return false;
+			}
+			header = reinterpret_cast<const TreeFileHeader *>(data);
+
+			uint64_t expected = sizeof(TreeFileHeader)
+			                    + 4 * (uint64_t(header->symbolCount) + 1)
+			                    + 4 * (uint64_t(header->ruleCount) + 1)
+			                    + 4 * uint64_t(header->ruleSymbolCount)
+			                    + sizeof(TreeFileNode) * uint64_t(header->nodeCount)
+			                    + 4 * (uint64_t(header->lexemeCount) + 1)
+			                    + header->nameBytes + header->lexemeBytes;
+			if (expected != size) {
+				error = "ERROR: Truncated or corrupt binary parse tree";
+				return false;
+			}
+
+			nameOffsets = reinterpret_cast<const uint32_t *>(data + sizeof(TreeFileHeader));
+			ruleOffsets = nameOffsets + header->symbolCount + 1;
+			ruleSymbols = ruleOffsets + header->ruleCount + 1;
+			nodes = reinterpret_cast<const TreeFileNode *>(ruleSymbols + header->ruleSymbolCount);
+			lexemeOffsets = reinterpret_cast<const uint32_t *>(nodes + header->nodeCount);
+			names = reinterpret_cast<const char *>(lexemeOffsets + header->lexemeCount + 1);
+			lexemes = names + header->nameBytes;
+
+			bool valid = validStrings(nameOffsets, header->symbolCount, header->nameBytes)
+			             && validStrings(ruleOffsets, header->ruleCount, header->ruleSymbolCount)
+			             && validStrings(lexemeOffsets, header->lexemeCount, header->lexemeBytes);
+			for (uint32_t r = 0; valid && r < header->ruleCount; ++r) {
+				valid = ruleOffsets[r] < ruleOffsets[r + 1];
+			}
+			for (uint32_t i = 0; valid && i < header->ruleSymbolCount; ++i) {
+				valid = ruleSymbols[i] < header->symbolCount;
+			}
+			valid = valid && header->identifierCount <= header->lexemeCount;
+			// symbol id of ID, whose leaves must name an identifier, or -1 if the grammar has none
+			int64_t idSymbol = -1;
+			for (uint32_t s = 0; valid && s < header->symbolCount; ++s) {
+				if (nameOffsets[s + 1] - nameOffsets[s] == 2 && std::equal(names + nameOffsets[s], names + nameOffsets[s + 1], "ID")) {
+					idSymbol = s;
+				}
+			}
+			// every node's children must be in the file, and the root's subtree must be all of it
+			uint64_t pending = 1;
+			for (uint32_t i = 0; valid && i < header->nodeCount; ++i) {
+				const TreeFileNode &node = nodes[i];
+				if (node.rule >= 0) {
+					valid = uint32_t(node.rule) < header->ruleCount && pending > 0
+					        && node.value == ruleOffsets[node.rule + 1] - ruleOffsets[node.rule] - 1;
+				}
+				else {
+					valid = uint32_t(~node.rule) < header->symbolCount && node.value < header->lexemeCount && pending > 0
+					        && (~node.rule != idSymbol || node.value < header->identifierCount);
+				}
+				pending += (node.rule >= 0 ? node.value : 0);
+				--pending;
+			}
+			if (!valid || pending != 0) {
+				error = "ERROR: Corrupt binary parse tree";
+				return false;
+			}
+			return true;
+		}
+
+		uint32_t symbolCount() const { return header->symbolCount; }
+		std::string symbol(uint32_t s) const {
+			return std::string(names + nameOffsets[s], nameOffsets[s + 1] - nameOffsets[s]);
+		}
+
+		uint32_t ruleCount() const { return header->ruleCount; }
+		// symbols of rule r, LHS first, are ruleSymbol(r, 0) to ruleSymbol(r, ruleLength(r) - 1)
+		uint32_t ruleLength(uint32_t r) const { return ruleOffsets[r + 1] - ruleOffsets[r]; }
+		uint32_t ruleSymbol(uint32_t r, uint32_t i) const { return ruleSymbols[ruleOffsets[r] + i]; }
+
+		uint32_t nodeCount() const { return header->nodeCount; }
+		const TreeFileNode &node(uint32_t i) const { return nodes[i]; }
+
+		uint32_t lexemeCount() const { return header->lexemeCount; }
+		// the identifier with id i is lexeme(i), for i < identifierCount()
+		uint32_t identifierCount() const { return header->identifierCount; }
+		std::string lexeme(uint32_t i) const {
+			return std::string(lexemes + lexemeOffsets[i], lexemeOffsets[i + 1] - lexemeOffsets[i]);
+		}
+};
+#endif
@@ -1,237 +1,773 @@
 #include <utility>
 #include <iostream>
 #include <vector>
-#include <map>
+#include <unordered_map>
 #include <string>
 #include <sstream>
 #include <algorithm>
 #include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <climits>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include "../../a5/A5P1/tokenstream.h"
+#include "../lrtable.h"
+#include "../lrparse.h"
+#include "treefile.h"
+#include "wlp4table.h"
 using namespace std;
 
-// class representing each node in the parse tree generated by the "Parser" class
-class Node {
-	public:
-		string token;
-		string lexeme;
-		vector<Node> children;
+// Reads the whitespace-separated words of a file a buffer at a time, for the "KIND lexeme" token lines
+// produced by wlp4scan, without the per-word overhead of extracting strings from cin
+class WordReader {
+	int fd;
+	vector<char> buffer;
+	size_t pos = 0;
+	size_t end = 0;
+
+	// function to read the next part of the file into the buffer, returns false at the end of the file
+	bool fill() {
+		pos = 0;
+		ssize_t n = read(fd, buffer.data(), buffer.size());
+		end = n > 0 ? n : 0;
+		return end > 0;
+	}
+
+	static bool isSpace(char c) {
+		return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+	}
 
-		// constructor
-		Node(string id) : token{id} {}
+	public:
+		WordReader(int fd) : fd{fd}, buffer(1 << 16) {}
+
+		// function to append the next word to out, returns false if there are no words left
+		bool next(string &out) {
+			for (;;) {
+				while (pos < end && isSpace(buffer[pos])) {
+					++pos;
+				}
+				if (pos < end) {
+					break;
+				}
+				if (!fill()) {
+					return false;
+				}
+			}
+			for (;;) {
+				size_t start = pos;
+				while (pos < end && !isSpace(buffer[pos])) {
+					++pos;
+				}
+				out.append(buffer.data() + start, pos - start);
+				if (pos < end || !fill()) {
+					return true;
+				}
+			}
+		}
 };
 
 class Parser {
-	vector<string> terminals;
-	vector<string> nonTerminals;
-	string startSymbol;
-	vector<vector<string>> productionRules;
-	int numStates;
+	// the grammar symbols (terminals first), the rules, and the ACTION/GOTO table as loaded, with one
+	// entry per (state, symbol) (see ../lrtable.h)
+	// 0 is an error, s + 1 shifts to (or, for a non-terminal, goes to) state s, and -(r + 1) reduces by rule r
+	LrGrammar grammar;
+
+	// the same entries in the layout the parse uses (see useLayout)
+	LrActions table;
+
+	// where the input tokens are read from, a token at a time (see openInput): the text lines of wlp4scan,
+	// or a binary token stream and the index of its next token
+	WordReader words{0};
+	TokenStream stream;
+	bool binaryInput = false;
+	size_t streamNext = 0;
+
+	// grammar symbol ids of the tokens read so far, including BOF and EOF (-1 for a kind not in the grammar)
+	vector<int> tokens;
+
+	// lexemes of the tokens read so far, stored end to end: token n's is [lexemeEnds[n - 1], lexemeEnds[n])
+	string lexemeBytes;
+	vector<uint32_t> lexemeEnds;
+
+	// grammar symbol ids of the token kinds of a binary token stream
+	int kindSymbols[Token::COMMENT + 1];
+
+	// function to add a token to the input, with the lexeme already appended to lexemeBytes
+	void endToken(int symbol) {
+		tokens.push_back(symbol);
+		lexemeEnds.push_back(lexemeBytes.size());
+	}
 
-	// shift actions
-	map<pair<int, string>, int> shift;
+	// function to read the next input token, returns false at the end of the input
+	bool nextToken() {
+		if (binaryInput) {
+			if (streamNext == stream.tokenCount()) {
+				return false;
+			}
+			lexemeBytes += stream.lexeme(streamNext);
+			endToken(kindSymbols[stream.kind(streamNext++)]);
+			return true;
+		}
+		string kind;
+		if (!words.next(kind)) {
+			return false;
+		}
+		// a missing last lexeme is empty
+		words.next(lexemeBytes);
+		endToken(symbolId(kind));
+		return true;
+	}
 
-	// reduce actions
-	map<pair<int, string>, int> reduce;
+	// function to report the error of a parse that stopped after error tokens were shifted (see lrParse)
+	// returns true if there was none
+	bool accepted(int error) const {
+		if (error == -1) {
+			return true;
+		}
+		// an error after the last token is counted past it
+		cerr << "ERROR at " << (error < static_cast<int>(tokens.size()) ? error : error + 1) << endl;
+		return false;
+	}
 
 	public:
 
-	void dataRead() {
-
-		ifstream inp ("wlp4.cfg");
-
-		int counter;	
-	
-		// read and store terminals
-		inp >> counter;
-		string terminal;
-		for (int i = 0; i < counter; ++i) {
-			inp >> terminal;
-			this->terminals.push_back(terminal);
-		}
-
-		// read and store non-terminals
-		inp >> counter;
-		string nonTerminal;
-		for (int i = 0; i < counter; ++i) {
-			inp >> nonTerminal;
-			this->nonTerminals.push_back(nonTerminal);
-		}
-
-		// read and store start symbol
-		inp >> this->startSymbol;
-		
-		// read and store production rules in a vector storing vectors of strings
-                // the first element in each rule vector is the LHS
-                // every element after stores the terminals/non-terminals in the RHS of the rule (as they appear in the rule)
-		inp >> counter;
-		string line;
-		getline(inp, line); // move to next line
-		string symbol;
-		for (int i = 0; i < counter; ++i) {
-			this->productionRules.push_back(vector<string>()); // push back empty vector -> this will store the current rule
-			getline(inp, line);
-			stringstream ss{line};
-			while (ss >> symbol) {
-				this->productionRules[i].push_back(symbol);	
-			}
-		} 
-
-		// read and store number of states
-		inp >> this->numStates;
-
-		// read and store the shift and reduce actions
-		inp >> counter;
-		pair<int, string> p;
-		int move;
-		string check;
-		for (int i = 0; i < counter; ++i) {
-			inp >> p.first; // current state
-			inp >> p.second; // terminal/nonTerminal -> look ahead
-			inp >> check; // check to see if the action is shift or reduce
-			inp >> move; // end state of action
-			if (check == "shift") {
-				this->shift[p] = move;
-			}
-			else if (check == "reduce") {
-				this->reduce[p] = move;
+	// load the grammar and parse table compiled in from wlp4table.h (generated by cfg2header from wlp4.cfg)
+	void embeddedRead() {
+		grammar.symbols.assign(wlp4Symbols, wlp4Symbols + wlp4NumSymbols);
+		grammar.numTerminals = wlp4NumTerminals;
+		grammar.startSymbol = wlp4StartSymbol;
+		grammar.ruleOffsets.assign(wlp4RuleOffsets, wlp4RuleOffsets + wlp4NumRules + 1);
+		grammar.ruleSymbols.assign(wlp4RuleSymbols, wlp4RuleSymbols + wlp4RuleOffsets[wlp4NumRules]);
+		grammar.numStates = wlp4NumStates;
+		grammar.actions.assign(wlp4Actions, wlp4Actions + wlp4NumStates * wlp4NumSymbols);
+		grammar.index();
+	}
+
+	// load a grammar and its parse table from a .cfg file or a binary table written by "lrgen --binary"
+	// (see ../lrtable.h), returns false if it can't be read
+	bool dataRead(const string &file) {
+
+		ifstream inp (file, ios::binary);
+		if (!inp) {
+			cerr << "ERROR: Cannot open grammar file " << file << endl;
+			return false;
+		}
+		string error;
+		if (isLrTable(inp)) {
+			if (!readLrTable(inp, grammar, error)) {
+				cerr << error << endl;
+				return false;
 			}
+			grammar.index();
+		}
+		else if (!readCfg(inp, grammar, error)) {
+			cerr << error << endl;
+			return false;
 		}
 
 		inp.close();
+		return true;
 	}
 
 
-	void parse() {
-		vector<int> stateStack;
-		vector<Node> symStack;
-		vector<Node> input;
+	// open the input on stdin, as text lines or as a binary token stream, and add BOF to it
+	// returns false if the binary stream is malformed
+	bool openInput(bool binary) {
+		binaryInput = binary;
+		if (binary) {
+			string error;
+			if (!stream.open(0, error)) {
+				cerr << error << endl;
+				return false;
+			}
+			for (int k = 0; k <= Token::COMMENT; ++k) {
+				kindSymbols[k] = symbolId(tokenKindNames[k]);
+			}
+			tokens.reserve(stream.tokenCount() + 2);
+			lexemeEnds.reserve(stream.tokenCount() + 2);
+		}
+		lexemeBytes += "BOF";
+		endToken(symbolId("BOF"));
+		return true;
+	}
 
-		// create input vector -> manually store BOF and EOF
-		Node b{"BOF"};
-		b.lexeme = "BOF";
-		input.push_back(b);
+	// read the rest of the opened input, followed by EOF, for the parses that need all of it at once
+	void readInput() {
+		while (nextToken()) {
+		}
+		lexemeBytes += "EOF";
+		endToken(symbolId("EOF"));
+	}
+
+	// pack the loaded ACTION/GOTO entries into layout (see lrtable.h); must be called before parsing
+	void useLayout(LrLayout layout) {
+		table = packActions(grammar, layout);
+	}
 
-		string id;
-		string lex;
-		while (cin >> id) {
-			Node n{id};
-			cin >> lex;
-			n.lexeme = lex;
-			input.push_back(n);
+	// parse the input, reporting each shift and reduction to builder (see lrparse.h)
+	// returns false, after printing the error, if the input is rejected
+	// (the input must have been read with readInput)
+	template <typename Builder>
+	bool parse(Builder &builder) const {
+		return accepted(table.visit([&](const auto &actions) {
+			return lrParse(actions, grammar.rules, builder, tokens.data(), tokens.size());
+		}));
+	}
+
+	// parse the opened input as it is read, so that no token is read past an error and each one is
+	// shifted as soon as it is stored; otherwise the same as parse
+	template <typename Builder>
+	bool parseInput(Builder &builder) {
+		return accepted(table.visit([&](const auto &actions) {
+			auto driver = makeLrDriver(actions, grammar.rules, builder);
+			int n = 0;
+			for (;; ++n) {
+				if (!driver.shift(n, tokens[n])) {
+					return n;
+				}
+				if (n + 1 == static_cast<int>(tokens.size()) && !nextToken()) {
+					break;
+				}
+			}
+			lexemeBytes += "EOF";
+			endToken(symbolId("EOF"));
+			++n;
+			if (!driver.shift(n, tokens[n])) {
+				return n;
+			}
+			return driver.accept() ? -1 : n + 1;
+		}));
+	}
+
+	/* Split the input for a parallel parse: a WLP4 program is BOF, procedures, main and EOF, and each
+	 * procedure (or main) starts with INT ID LPAREN (or INT WAIN LPAREN) outside any braces. Returns the
+	 * index of the first token of each procedure and of main, in order, or nothing if the input doesn't
+	 * have that shape (it may still parse; see parseParallel). The grammar must have the WLP4 symbols.
+	 */
+	vector<int> procedureStarts() const {
+		int intSymbol = symbolId("INT");
+		int idSymbol = symbolId("ID");
+		int wainSymbol = symbolId("WAIN");
+		int lparen = symbolId("LPAREN");
+		int lbrace = symbolId("LBRACE");
+		int rbrace = symbolId("RBRACE");
+		vector<int> starts;
+		if (intSymbol == -1 || idSymbol == -1 || wainSymbol == -1 || lparen == -1 || lbrace == -1 || rbrace == -1
+		    || symbolId("procedure") == -1 || symbolId("main") == -1) {
+			return starts;
+		}
+		int bof = symbolId("BOF");
+		int eof = symbolId("EOF");
+		if (procedureState(0) < 0 || procedureState(1) < 0) {
+			return starts;
 		}
+		int inputSize = tokens.size();
+		int depth = 0;
+		for (int i = 1; i + 1 < inputSize; ++i) {
+			if (tokens[i] == bof || tokens[i] == eof) {
+				// only the sequential parse can tell where these go wrong
+				starts.clear();
+				return starts;
+			}
+			else if (tokens[i] == lbrace) {
+				++depth;
+			}
+			else if (tokens[i] == rbrace) {
+				--depth;
+			}
+			else if (depth == 0 && i + 2 < inputSize && tokens[i] == intSymbol
+			         && (tokens[i + 1] == idSymbol || tokens[i + 1] == wainSymbol) && tokens[i + 2] == lparen) {
+				starts.push_back(i);
+			}
+		}
+		// only the last one may be (and must be) main, and nothing may come before the first
+		for (size_t k = 0; k < starts.size(); ++k) {
+			if ((tokens[starts[k] + 1] == wainSymbol) != (k + 1 == starts.size())) {
+				starts.clear();
+				return starts;
+			}
+		}
+		if (starts.empty() || starts[0] != 1) {
+			starts.clear();
+		}
+		return starts;
+	}
+
+	// return the state a procedure (or main) starts in, after BOF and k procedures
+	int procedureState(int k) const {
+		int state = action(0, symbolId("BOF")) - 1;
+		return k == 0 ? state : action(state, symbolId("procedure")) - 1;
+	}
 
-		Node e("EOF");
-		e.lexeme = "EOF";
-		input.push_back(e);
+	// parse input tokens [first, last) as procedure number k (or main, if it is the last one) into builder,
+	// the way parse would reach it, with the token at last as the lookahead
+	// returns the handle of its node, or -1 if the tokens are not exactly one procedure (or main)
+	template <typename Builder>
+	int parseProcedure(Builder &builder, int first, int last, int k, bool isMain) const {
+		return table.visit([&](const auto &actions) {
+			int start = procedureState(k);
+			auto driver = makeLrDriver(actions, grammar.rules, builder, start);
+			for (int i = first; i < last; ++i) {
+				if (!driver.shift(i, tokens[i])) {
+					return -1;
+				}
+			}
+			// reduce until the procedure is the only symbol on the stack, the way parse would before
+			// shifting the lookahead (or before reducing procedures, for main)
+			int done = action(start, symbolId(isMain ? "main" : "procedure")) - 1;
+			while (driver.states.size() != 2 || driver.states[1] != done) {
+				int act = driver.action(tokens[last]);
+				if (act >= 0 || grammar.rules.length[-act - 1] >= static_cast<int>(driver.states.size())) {
+					return -1;
+				}
+				driver.reduceBy(-act - 1);
+			}
+			return driver.handles[0];
+		});
+	}
 
-		stateStack.push_back(0);
+	// finish a parallel parse into builder: parse BOF, the procedures and main (already parsed, with the
+	// given handles) and EOF, returns false if they are rejected
+	template <typename Builder>
+	bool parseProcedures(Builder &builder, const vector<int> &handles) const {
+		return table.visit([&](const auto &actions) {
+			auto driver = makeLrDriver(actions, grammar.rules, builder);
+			int inputSize = tokens.size();
+			if (!driver.shift(0, tokens[0])) {
+				return false;
+			}
+			// the procedures are pushed through their GOTO entries
+			for (size_t k = 0; k < handles.size(); ++k) {
+				int act = driver.reduceOn(symbolId(k + 1 == handles.size() ? "main" : "procedure"));
+				if (act == 0) {
+					return false;
+				}
+				driver.push(handles[k], act);
+			}
+			return driver.shift(inputSize - 1, tokens[inputSize - 1]) && driver.accept();
+		});
+	}
 
-		int ruleSize;
-		int readCount = 0;
+	// return the id of grammar symbol s, or -1 if s is not in the grammar
+	int symbolId(const string &s) const {
+		return grammar.symbolId(s);
+	}
 
-		// use to check the shift and reduce vectors
-		pair<int, string> check;
+	// return the ACTION/GOTO entry for symbol in state n (see grammar), 0 for a symbol not in the grammar
+	int action(int n, int symbol) const {
+		return symbol == -1 ? 0 : table.action(n, symbol);
+	}
 
-		int inputSize = input.size();
+	// name of grammar symbol s
+	const string &symbolName(int s) const {
+		return grammar.symbols[s];
+	}
 
-		for (int i = 0; i < inputSize; ++i) {
+	// return true if grammar symbol s is a terminal
+	bool isTerminal(int s) const {
+		return grammar.isTerminal(s);
+	}
 
-			// current input symbol
-			string symbol = input[i].token;
-			
-			for (int rule = reduction(stateStack.back(), symbol); rule != -1; rule = reduction(stateStack.back(), symbol)) {
-				ruleSize = productionRules[rule].size();
-				
-				// initializze a new node with symbol on LHS of production rule
-				Node parent{productionRules[rule][0]};
-				
-				// insert nodes from symStack that are to be popped off as children of arent node
-				parent.children.insert(parent.children.begin(), symStack.end() - ruleSize + 1, symStack.end());
+	// left hand side symbol id of rule
+	int lhs(int rule) const {
+		return grammar.rules.lhs[rule];
+	}
 
-				for (int i = 0; i < ruleSize - 1; ++i) {
-                                        stateStack.pop_back();
-					symStack.pop_back();
-                                }
+	// number of grammar symbols, and of production rules
+	int symbolCount() const {
+		return grammar.symbols.size();
+	}
+	int ruleCount() const {
+		return grammar.numRules();
+	}
 
-				// push new node onto symbol stack
-				symStack.push_back(parent);
+	// symbol ids of rule, LHS first
+	vector<int> ruleSymbols(int rule) const {
+		return vector<int>(grammar.ruleSymbols.begin() + grammar.ruleOffsets[rule],
+		                   grammar.ruleSymbols.begin() + grammar.ruleOffsets[rule + 1]);
+	}
 
-				check.first = stateStack.back(); 
-				check.second = parent.token;
-				
-				// push next state onto stateStack
-				stateStack.push_back(shift[check]);
+	// number of input tokens, including BOF and EOF
+	int tokenCount() const {
+		return tokens.size();
+	}
+
+	// grammar symbol id of input token n
+	int tokenSymbol(int n) const {
+		return tokens[n];
+	}
+
+	// lexeme of input token n, in place and as a string
+	const char *lexemeData(int n) const {
+		return lexemeBytes.data() + (n == 0 ? 0 : lexemeEnds[n - 1]);
+	}
+	size_t lexemeSize(int n) const {
+		return lexemeEnds[n] - (n == 0 ? 0 : lexemeEnds[n - 1]);
+	}
+	string lexeme(int n) const {
+		return string(lexemeData(n), lexemeSize(n));
+	}
+
+	// function to list the identifiers of the input by the ids wlp4scan interned them with, and set ids[n] to the
+	// id of token n if it is an ID: a binary token stream carries the ids, and from text they are numbered the way
+	// wlp4scan numbers them, in order of first appearance
+	void identifiers(vector<string> &names, vector<uint32_t> &ids) const {
+		int idSymbol = symbolId("ID");
+		ids.assign(tokens.size(), 0);
+		if (binaryInput) {
+			for (size_t i = 0; i < stream.identifierCount(); ++i) {
+				names.push_back(stream.identifier(i));
 			}
-			
-			// push current symbol on to symStack
-			symStack.push_back(input[i]);
-			
-			check.first = stateStack.back();
-			check.second = symbol;
-			
-			// reject or continue parse
-			if (shift.count(check) == 0) {
-				cerr << "ERROR at " << readCount << endl;
-				return;
+			// token n is token n - 1 of the stream, after BOF
+			for (size_t n = 1; n + 1 < tokens.size(); ++n) {
+				if (stream.kind(n - 1) == Token::ID) {
+					ids[n] = stream.value(n - 1);
+				}
 			}
-			else {
-				stateStack.push_back(shift[check]);
-				readCount += 1;
+			return;
+		}
+		unordered_map<string, uint32_t> idOf;
+		for (size_t n = 0; n < tokens.size(); ++n) {
+			if (idSymbol != -1 && tokens[n] == idSymbol) {
+				string name = lexeme(n);
+				auto it = idOf.emplace(name, names.size()).first;
+				if (it->second == names.size()) {
+					names.push_back(name);
+				}
+				ids[n] = it->second;
 			}
 		}
+	}
+};
 
-		// check if reduction on rule 0 is possible
-                if (symStack.size() != productionRules[0].size() - 1) {
-                        cerr << "ERROR at " << readCount + 1 << endl;
-                        return;
-                }
+// builder that keeps the whole parse tree (see LrTree), so that it can be printed once the parse succeeds
+class ParseTree : public LrTree {
+	const Parser &parser;
 
-		// final reduction on rule 0
-		Node parent{productionRules[0][0]};
-		parent.children.insert(parent.children.begin(), symStack.begin(), symStack.end());
+	public:
+		ParseTree(const Parser &parser) : parser{parser} {}
+
+		// function to print the derivation of the node with handle n as a preorder traversal
+		// an explicit stack replaces recursion, so long statement lists can't overflow the call stack,
+		// and the lines are buffered instead of flushing each one
+		void print(int n) {
+			int bof = parser.symbolId("BOF");
+			int eof = parser.symbolId("EOF");
+			string out;
+
+			// function to append the line for the node with handle h: the rule, or the token and its lexeme
+			auto line = [&](int h) {
+				if (h >= 0) {
+					const LrNode &node = nodes[h];
+					out += parser.symbolName(parser.lhs(node.rule));
+					for (int c = node.first; c < node.first + node.count; ++c) {
+						int child = children[c];
+						out += ' ';
+						out += parser.symbolName(child < 0 ? parser.tokenSymbol(~child) : parser.lhs(nodes[child].rule));
+					}
+				}
+				else {
+					int symbol = parser.tokenSymbol(~h);
+					out += parser.symbolName(symbol);
+					// an input token named after a non-terminal is a leaf with no children
+					if (symbol == bof || symbol == eof || parser.isTerminal(symbol)) {
+						out += ' ';
+						out.append(parser.lexemeData(~h), parser.lexemeSize(~h));
+					}
+				}
+				out += '\n';
+				if (out.size() >= (1 << 16)) {
+					fwrite(out.data(), 1, out.size(), stdout);
+					out.clear();
+				}
+			};
+
+			// each entry is a node and the position of the next of its children to visit
+			vector<pair<int, int>> stack{{n, 0}};
+			line(n);
+			while (!stack.empty()) {
+				auto &top = stack.back();
+				const LrNode &node = nodes[top.first];
+				if (top.second == node.count) {
+					stack.pop_back();
+					continue;
+				}
+				int child = children[node.first + top.second++];
+				line(child);
+				if (child >= 0) {
+					stack.emplace_back(child, 0);
+				}
+			}
+			fwrite(out.data(), 1, out.size(), stdout);
+			fflush(stdout);
+		}
 
-		// print derivation
-		print(&parent);
-	}
+		// function to write the tree under the node with handle n as a binary parse tree (see treefile.h)
+		void writeBinary(int n) {
+			vector<string> symbols;
+			for (int s = 0; s < parser.symbolCount(); ++s) {
+				symbols.push_back(parser.symbolName(s));
+			}
+			vector<uint32_t> ruleOffsets{0};
+			vector<uint32_t> ruleSymbols;
+			for (int r = 0; r < parser.ruleCount(); ++r) {
+				for (int symbol : parser.ruleSymbols(r)) {
+					ruleSymbols.push_back(symbol);
+				}
+				ruleOffsets.push_back(ruleSymbols.size());
+			}
 
-	// return -1 if no reduction possible
-	// else return the rule used
-	int reduction(int n, string s) {
-		pair<int, string> check (n, s);
-		if (reduce.count(check) == 0) {
-			return -1;
+			// each distinct lexeme is stored once, the identifiers first so that an ID leaf's lexeme is its id
+			vector<string> lexemes;
+			vector<uint32_t> identifierIds;
+			parser.identifiers(lexemes, identifierIds);
+			uint32_t identifierCount = lexemes.size();
+			int idSymbol = parser.symbolId("ID");
+			unordered_map<string, uint32_t> lexemeIds;
+			vector<uint32_t> lastLexeme(parser.symbolCount(), UINT32_MAX);
+			vector<TreeFileNode> preorder;
+			// every node but the root is some node's child
+			preorder.reserve(children.size() + 1);
+
+			// function to append the record for the node with handle h
+			auto record = [&](int h) {
+				if (h >= 0) {
+					preorder.push_back(TreeFileNode{nodes[h].rule, static_cast<uint32_t>(nodes[h].count)});
+				}
+				else if (parser.tokenSymbol(~h) == idSymbol) {
+					preorder.push_back(TreeFileNode{~idSymbol, identifierIds[~h]});
+				}
+				else {
+					// most terminals always have the same lexeme, so try the last one of the symbol before hashing
+					int symbol = parser.tokenSymbol(~h);
+					string lexeme = parser.lexeme(~h);
+					uint32_t &last = lastLexeme[symbol];
+					if (last == UINT32_MAX || lexemes[last] != lexeme) {
+						auto it = lexemeIds.emplace(lexeme, lexemes.size()).first;
+						if (it->second == lexemes.size()) {
+							lexemes.push_back(lexeme);
+						}
+						last = it->second;
+					}
+					preorder.push_back(TreeFileNode{~symbol, last});
+				}
+			};
+
+			// each entry is a node and the position of the next of its children to visit
+			vector<pair<int, int>> stack{{n, 0}};
+			record(n);
+			while (!stack.empty()) {
+				auto &top = stack.back();
+				const LrNode &node = nodes[top.first];
+				if (top.second == node.count) {
+					stack.pop_back();
+					continue;
+				}
+				int child = children[node.first + top.second++];
+				record(child);
+				if (child >= 0) {
+					stack.emplace_back(child, 0);
+				}
+			}
+			writeTreeFile(cout, symbols, ruleOffsets, ruleSymbols, preorder, lexemes, identifierCount);
+			cout.flush();
 		}
-		else {
-			return reduce[check];
+};
+
+// Segments smaller than this (in tokens) are not worth handing to another thread
+const int MIN_SHARD_TOKENS = 16 * 1024;
+
+// The procedures of one shard of a parallel parse, and the tree they are parsed into
+struct Shard {
+	int first; // the shard's procedures are first to last - 1, numbered as in procedureStarts
+	int last;
+	ParseTree tree;
+	vector<int> handles; // handle in tree of each procedure, or -1 if it didn't parse
+	Shard(const Parser &parser) : tree{parser} {}
+};
+
+/* Parse the input into tree with the procedures (and main) parsed independently on threads:
+ * procedureStarts splits the tokens, each procedure is parsed from the state the sequential parse
+ * would be in when it starts (parseProcedure), and the finished procedures are then reduced under
+ * procedures and start (parseProcedures). Returns false, printing nothing, if the input can't be
+ * split or any part of it is rejected; the caller parses it again sequentially to report the error.
+ */
+bool parseParallel(const Parser &parser, ParseTree &tree, unsigned threads) {
+	vector<int> starts = parser.procedureStarts();
+	if (starts.empty()) {
+		return false;
+	}
+	int procedureCount = starts.size();
+	// the last procedure (main) ends before EOF
+	starts.push_back(parser.tokenCount() - 1);
+
+	// split the procedures into contiguous shards of about the same number of tokens, several per
+	// thread so that shards of uneven cost still balance across the pool
+	int tokenCount = starts.back() - starts[0];
+	int shardCount = max(1, min<int>({int(threads) * 8, tokenCount / MIN_SHARD_TOKENS, procedureCount}));
+	vector<Shard> shards;
+	int next = 0;
+	for (int i = 0; i < shardCount && next < procedureCount; ++i) {
+		int last = next + 1;
+		int end = starts[0] + static_cast<long long>(tokenCount) * (i + 1) / shardCount;
+		while (last < procedureCount && starts[last] < end) {
+			++last;
 		}
+		if (i + 1 == shardCount) {
+			last = procedureCount;
+		}
+		shards.emplace_back(parser);
+		shards.back().first = next;
+		shards.back().last = last;
+		next = last;
 	}
 
-	// function to print derivation
-	void print(Node *n) {
-		cout << n->token;
-                for (auto &t : n->children) {
-                        cout << " " << t.token;
-                }
-                cout << endl;
-
-		vector<string>::iterator it;
-		vector<Node>::iterator it2 = n->children.begin();
-		for (; it2 != n->children.end(); ++it2) {
-			string sym = it2->token;
-			it = find (terminals.begin(), terminals.end(), sym);
-			if (sym != "BOF" && sym != "EOF" && it == terminals.end()) {
-				print(&(*it2));
-			}
-			else {
-				cout << sym << " " << it2->lexeme << endl;
+	// each worker takes the next unparsed shard until there are none left; workers share nothing
+	// but the (immutable) parser
+	atomic<size_t> nextShard{0};
+	auto worker = [&]() {
+		for (size_t i = nextShard++; i < shards.size(); i = nextShard++) {
+			Shard &shard = shards[i];
+			for (int k = shard.first; k < shard.last; ++k) {
+				int handle = parser.parseProcedure(shard.tree, starts[k], starts[k + 1], k, k + 1 == procedureCount);
+				shard.handles.push_back(handle);
+				if (handle == -1) {
+					break;
+				}
 			}
 		}
+	};
+
+	vector<thread> pool;
+	for (unsigned t = 1; t < threads && t < shards.size(); ++t) {
+		pool.emplace_back(worker);
 	}
-};
+	worker();
+	for (auto &t : pool) {
+		t.join();
+	}
+
+	// move the shards' trees into tree in order, and reduce them under procedures and start
+	vector<int> handles;
+	for (auto &shard : shards) {
+		if (shard.handles.size() != static_cast<size_t>(shard.last - shard.first) || shard.handles.back() == -1) {
+			return false;
+		}
+		int offset = tree.append(shard.tree);
+		for (int handle : shard.handles) {
+			handles.push_back(handle + offset);
+		}
+	}
+	return parser.parseProcedures(tree, handles);
+}
 
+// Usage: wlp4parse [--binary] [--binary-tree] [--threads N] [--table dense|comb|map] [--time] [-g grammar.cfg]
+//                  < foo.scanned
+// With --binary the input is a binary token stream from "wlp4scan --binary"
+// With --binary-tree the tree is written as a binary parse tree (see treefile.h) instead of the .wlp4i text
+// With --threads N the procedures are parsed in parallel on N threads (see parseParallel)
+// --table picks the layout of the parse table (see lrtable.h): dense (the default), comb or map
+// --time reports how long each phase took on stderr: loading the grammar, reading the input, the shifts and
+// reductions alone (an extra parse that builds no tree), the parse that builds the tree, and the output
+// Otherwise the input is parsed as it is read (see parseInput)
+// The WLP4 grammar and parse table are compiled in (see cfg2header); -g reads a different one from a .cfg file
+// or a binary table written by lrgen
+int main(int argc, char *argv[]) {
+	bool binary = false;
+	bool binaryTree = false;
+	unsigned threads = 0;
+	LrLayout layout = LR_DENSE;
+	bool timing = false;
+	string grammarFile;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--binary") {
+			binary = true;
+		}
+		else if (arg == "--binary-tree") {
+			binaryTree = true;
+		}
+		else if (arg == "--threads" && i + 1 < argc) {
+			const char *value = argv[++i];
+			char *end;
+			unsigned long n = strtoul(value, &end, 10);
+			if (!isdigit(static_cast<unsigned char>(*value)) || *end != '\0' || n > UINT_MAX) {
+				cerr << "ERROR: Bad thread count " << value << endl;
+				return 1;
+			}
+			threads = n;
+		}
+		else if (arg == "--table" && i + 1 < argc && lrLayoutFromName(argv[i + 1], layout)) {
+			++i;
+		}
+		else if (arg == "--time") {
+			timing = true;
+		}
+		else if (arg == "-g" && i + 1 < argc) {
+			grammarFile = argv[++i];
+		}
+		else {
+			cerr << "ERROR: Unknown argument " << arg << endl;
+			return 1;
+		}
+	}
+	auto last = chrono::steady_clock::now();
+	// function to report the time since the last phase ended
+	auto phase = [&](const char *name) {
+		auto now = chrono::steady_clock::now();
+		if (timing) {
+			cerr << name << " " << chrono::duration<double, milli>(now - last).count() << " ms" << endl;
+		}
+		last = now;
+	};
 
-int main() {
 	Parser p;
-	p.dataRead();
-	p.parse();
+	if (grammarFile.empty()) {
+		p.embeddedRead();
+	}
+	else if (!p.dataRead(grammarFile)) {
+		return 1;
+	}
+	p.useLayout(layout);
+	phase("load");
+	if (!p.openInput(binary)) {
+		return 0;
+	}
+	ParseTree tree{p};
+	bool parsed;
+	if (threads == 0 && !timing) {
+		parsed = p.parseInput(tree);
+	}
+	else {
+		// splitting the procedures, or timing the phases separately, needs the whole input first
+		p.readInput();
+		phase("read");
+		if (timing) {
+			LrNoTree none;
+			if (!p.parse(none)) {
+				return 0;
+			}
+			phase("parse");
+		}
+		parsed = threads > 0 && parseParallel(p, tree, threads);
+		if (!parsed) {
+			tree.clear();
+			parsed = p.parse(tree);
+		}
+	}
+	phase("tree");
+	if (parsed) {
+		// print derivation
+		if (binaryTree) {
+			tree.writeBinary(tree.root());
+		}
+		else {
+			tree.print(tree.root());
+		}
+		phase("output");
+	}
 	return 0;
 }
@@ -0,0 +1,478 @@
+// Generated by cfg2header -- do not edit.
+// Regenerate with: cfg2header wlp4 < grammar.cfg > wlp4table.h
+#ifndef CS241_WLP4TABLE_H
+#define CS241_WLP4TABLE_H
+
+constexpr int wlp4NumTerminals = 35;
+constexpr int wlp4NumNonTerminals = 17;
+constexpr int wlp4NumSymbols = 52;
+constexpr const char *wlp4Symbols[] = {
+	"AMP", "BECOMES", "BOF", "COMMA", "DELETE", "ELSE", "EOF", "EQ",
+	"GE", "GT", "ID", "IF", "INT", "LBRACE", "LBRACK", "LE",
+	"LPAREN", "LT", "MINUS", "NE", "NEW", "NULL", "NUM", "PCT",
+	"PLUS", "PRINTLN", "RBRACE", "RBRACK", "RETURN", "RPAREN", "SEMI", "SLASH",
+	"STAR", "WAIN", "WHILE", "start", "dcl", "dcls", "expr", "factor",
+	"lvalue", "procedure", "procedures", "main", "params", "paramlist", "statement", "statements",
+	"term", "test", "type", "arglist"
+};
+constexpr int wlp4StartSymbol = 35;
+
+constexpr int wlp4NumRules = 49;
+constexpr int wlp4RuleOffsets[] = {
+	0, 4, 7, 9, 22, 37, 38, 40, 42, 46, 48, 51, 52, 58, 64, 67,
+	68, 71, 76, 88, 96, 102, 108, 112, 116, 120, 124, 128, 132, 134, 138, 142,
+	144, 148, 152, 156, 158, 160, 162, 166, 169, 172, 178, 182, 187, 189, 193, 195,
+	198, 202
+};
+constexpr int wlp4RuleSymbols[] = {
+	35, 2, 42, 6, 42, 41, 42, 42, 43, 41, 12, 10, 16, 44, 29, 13,
+	37, 47, 28, 38, 30, 26, 43, 12, 33, 16, 36, 3, 36, 29, 13, 37,
+	47, 28, 38, 30, 26, 44, 44, 45, 45, 36, 45, 36, 3, 45, 50, 12,
+	50, 12, 32, 37, 37, 37, 36, 1, 22, 30, 37, 37, 36, 1, 21, 30,
+	36, 50, 10, 47, 47, 47, 46, 46, 40, 1, 38, 30, 46, 11, 16, 49,
+	29, 13, 47, 26, 5, 13, 47, 26, 46, 34, 16, 49, 29, 13, 47, 26,
+	46, 25, 16, 38, 29, 30, 46, 4, 14, 27, 38, 30, 49, 38, 7, 38,
+	49, 38, 19, 38, 49, 38, 17, 38, 49, 38, 15, 38, 49, 38, 8, 38,
+	49, 38, 9, 38, 38, 48, 38, 38, 24, 48, 38, 38, 18, 48, 48, 39,
+	48, 48, 32, 39, 48, 48, 31, 39, 48, 48, 23, 39, 39, 10, 39, 22,
+	39, 21, 39, 16, 38, 29, 39, 0, 40, 39, 32, 39, 39, 20, 12, 14,
+	38, 27, 39, 10, 16, 29, 39, 10, 16, 51, 29, 51, 38, 51, 38, 3,
+	51, 40, 10, 40, 32, 39, 40, 16, 40, 29
+};
+
+constexpr int wlp4NumStates = 132;
+constexpr int wlp4Actions[] = {
+	0, 0, 24, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, -7, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 65, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0, -48, 0, -48,
+	0, 0, 0, -48, -48, -48, 0, 0, 0, 0, 0, -48, 0, -48, -48, -48,
+	0, 0, 0, -48, -48, 0, 0, -48, 0, -48, -48, -48, -48, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -10, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	90, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 103, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -14, 0, 0, 0,
+	0, 0, -14, -14, -14, 0, 0, 0, -14, 0, 0, 0, 0, 0, 0, 0,
+	0, -14, 0, 0, -14, 0, 0, 0, -14, 0, -14, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	-13, 0, 0, 0, 0, 0, -13, -13, -13, 0, 0, 0, -13, 0, 0, 0,
+	0, 0, 0, 0, 0, -13, 0, 0, -13, 0, 0, 0, -13, 0, -13, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, -38, 0, -38, 0, 0, 0, -38, -38, -38, 0, 0, 0, 0, 0, -38,
+	0, -38, -38, -38, 0, 0, 0, -38, -38, 0, 0, -38, 0, -38, -38, -38,
+	-38, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 37, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, -32, 0, 0, 0, -32,
+	-32, -32, 0, 0, 0, 0, 0, -32, 0, -32, -32, -32, 0, 0, 0, -32,
+	-32, 0, 0, -32, 0, -32, -32, -32, -32, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -29,
+	0, 0, 0, -29, -29, -29, 0, 0, 0, 0, 0, -29, 0, -29, -29, -29,
+	0, 0, 0, 67, -29, 0, 0, -29, 0, -29, -29, 53, 47, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 86, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0, 0, -45, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 36, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 32, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 69, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 34, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 55, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 19, 40, 29, 0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0,
+	16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0,
+	0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 61, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 0, 104, 0, 0,
+	0, 0, 43, 0, 0, 0, 0, 0, -16, 0, 0, 0, 0, 0, -16, -16,
+	5, 0, 0, 0, -16, 0, 0, 0, 0, 0, 0, 0, 0, -16, -16, 0,
+	-16, 0, 0, 0, -16, 0, -16, 0, 64, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 110, 0, 0, 43, 0, 0, -36, 0, -36, 0, 0, 0, -36,
+	-36, -36, 0, 0, 0, 0, 0, -36, 81, -36, -36, -36, 0, 0, 0, -36,
+	-36, 0, 0, -36, 0, -36, -36, -36, -36, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 55, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 19, 63, 29, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 102, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 43, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 35, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 100, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 43, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 92, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, -3, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 21, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, -8, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, -37, 0, -37, 0, 0, 0, -37,
+	-37, -37, 0, 0, 0, 0, 0, -37, 0, -37, -37, -37, 0, 0, 0, -37,
+	-37, 0, 0, -37, 0, -37, -37, -37, -37, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 72, 0,
+	0, 0, 0, 0, 20, 0, 0, 0, 0, -23, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0, 0, -24, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0,
+	0, -25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 72, 0, 0, 0, 0, 0,
+	20, 0, 0, 0, 0, -26, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 72, 0,
+	0, 0, 0, 0, 20, 0, 0, 0, 0, -27, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0, 0, -28, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -5, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 75, 0, 0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 41, 0, 0, 0, 0, 0, 0, 0,
+	112, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, -2, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	6, 0, 0, 0, 0, 0, 0, 4, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 119, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 118, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 106, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	6, 0, 0, 0, 0, 0, 33, 11, 0, 0, 0, 0, 0, 0, 0, 0,
+	12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 96, 52, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 48,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -33,
+	0, 0, 0, -33, -33, -33, 0, 0, 0, 0, 0, -33, 0, -33, -33, -33,
+	0, 0, 0, -33, -33, 0, 0, -33, 0, -33, -33, -33, -33, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, -34, 0, 0, 0, -34, -34, -34, 0, 0, 0, 0, 0, -34,
+	0, -34, -34, -34, 0, 0, 0, -34, -34, 0, 0, -34, 0, -34, -34, -34,
+	-34, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, -35, 0, 0, 0, -35, -35, -35, 0, 0,
+	0, 0, 0, -35, 0, -35, -35, -35, 0, 0, 0, -35, -35, 0, 0, -35,
+	0, -35, -35, -35, -35, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 91, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 8, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	6, 0, 0, 0, 0, 0, 0, 49, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 75, 0,
+	0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 41, 0, 0, 0, 0, 0, 0, 0, 128, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 70, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 57, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 80, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	25, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, -17, 0, 0, 0, 0, 0, -17, -17,
+	0, 0, 0, 0, -17, 0, 0, 0, 0, 0, 0, 0, 0, -17, -17, 0,
+	-17, 0, 0, 0, -17, 0, -17, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 107, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	-16, 0, 0, 0, 0, 0, -16, -16, 5, 0, 0, 0, -16, 0, 0, 0,
+	0, 0, 0, 0, 0, -16, -16, 0, -16, 0, 0, 0, -16, 0, -16, 0,
+	64, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 130, 0, 0, 43, 0,
+	0, 0, 0, -30, 0, 0, 0, -30, -30, -30, 0, 0, 0, 0, 0, -30,
+	0, -30, -30, -30, 0, 0, 0, 67, -30, 0, 0, -30, 0, -30, -30, 53,
+	47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, -31, 0, 0, 0, -31, -31, -31, 0, 0,
+	0, 0, 0, -31, 0, -31, -31, -31, 0, 0, 0, 67, -31, 0, 0, -31,
+	0, -31, -31, 53, 47, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 99, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 46, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0, 0, 98, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 117,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 50,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 87, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, -21, 0, 0, 0, 0, 0, -21, -21, 0, 0, 0, 0,
+	-21, 0, 0, 0, 0, 0, 0, 0, 0, -21, -21, 0, -21, 0, 0, 0,
+	-21, 0, -21, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 113, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 122, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 54, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0,
+	16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0,
+	0, 0, 0, 11, 0, 0, 0, 0, 0, 0, 0, 0, 62, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -46, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 76, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 0, 0, 0, 0, -47, 0, -47, 0, 0, 0, -47,
+	-47, -47, 0, 0, 0, 0, 0, -47, 0, -47, -47, -47, 0, 0, 0, -47,
+	-47, 0, 0, -47, 0, -47, -47, -47, -47, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 72, 0,
+	0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 88, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, -16, 0, 0, 0, 0, 0, -16, -16, 0, 0, 0, 0,
+	-16, 0, 0, 0, 0, 0, 0, 0, 0, -16, -16, 0, -16, 0, 0, 0,
+	-16, 0, -16, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 115,
+	0, 0, 0, 0, 0, 0, 0, 0, -16, 0, 0, 0, 0, 0, -16, -16,
+	0, 0, 0, 0, -16, 0, 0, 0, 0, 0, 0, 0, 0, -16, -16, 0,
+	-16, 0, 0, 0, -16, 0, -16, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 114, 0, 0, 0, 0, 0, 0, 0, 0, -16, 0, 0, 0,
+	0, 0, -16, -16, 0, 0, 0, 0, -16, 0, 0, 0, 0, 0, 0, 0,
+	0, -16, -16, 0, -16, 0, 0, 0, -16, 0, -16, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 116, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 89, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0, 0, 94, 0, 0,
+	6, 0, 0, 0, 0, 0, 13, 11, 0, 0, 0, 0, 0, 0, 0, 0,
+	12, 0, 0, 51, 0, 0, 0, 0, 0, 97, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -20, 0, 0, 0,
+	0, 0, -20, -20, 0, 0, 0, 0, -20, 0, 0, 0, 0, 0, 0, 0,
+	0, -20, -20, 0, -20, 0, 0, 0, -20, 0, -20, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	-19, 0, 0, 0, 0, 0, -19, -19, 0, 0, 0, 0, -19, 0, 0, 0,
+	0, 0, 0, 0, 0, -19, -19, 0, -19, 0, 0, 0, -19, 0, -19, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 111, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 13, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 0, 0, 73, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 125, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 38, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	6, 0, 0, 0, 0, 0, 123, 11, 0, 0, 0, 0, 0, 0, 0, 0,
+	12, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -11, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, -44, 0, -44, 0, 0, 0, -44,
+	-44, -44, 0, 0, 0, 0, 0, -44, 0, -44, -44, -44, 0, 0, 0, -44,
+	-44, 0, 0, -44, 0, -44, -44, -44, -44, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, -4, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 95, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, -43, 0, -43, 0, 0, 0, -43, -43, -43, 0, 0,
+	0, 0, 0, -43, 0, -43, -43, -43, 0, 0, 0, -43, -43, 0, 0, -43,
+	0, -43, -43, -43, -43, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -12, 0, 0, 0,
+	0, 0, -12, -12, -12, 0, 0, 0, -12, 0, 0, 0, 0, 0, 0, 0,
+	0, -12, 0, 0, -12, 0, 0, 0, -12, 0, -12, 0, 0, 22, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 7, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 79, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, -39, 0, -39, 0, 0, 0, -39, -39, -39, 0, 0,
+	0, 0, 0, -39, 0, -39, -39, -39, 0, 0, 0, -39, -39, 0, 0, -39,
+	0, -39, -39, -39, -39, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 93, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, -49, 0, -49, 0, 0, 0, -49, -49, -49, 0, 0, 0, 0, 0, -49,
+	0, -49, -49, -49, 0, 0, 0, -49, -49, 0, 0, -49, 0, -49, -49, -49,
+	-49, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 27, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, -41, 0, -41, 0, 0, 0, -41,
+	-41, -41, 0, 0, 0, 0, 0, -41, 0, -41, -41, -41, 0, 0, 0, -41,
+	-41, 0, 0, -41, 0, -41, -41, -41, -41, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, -9, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0, 0, 0, 0, 0,
+	3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	6, 0, 0, 0, 0, 0, 109, 11, 0, 0, 0, 0, 0, 0, 0, 0,
+	12, 121, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0, 0, 0, 23, 0,
+	0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 109, 11, 0, 0, 0, 0,
+	0, 0, 0, 0, 12, 120, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 124, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 105, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 15, 14, 10, 0, 0, 0, 0, 0, 26,
+	0, 18, 72, 45, 0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 56, 0, 0, 0, 0, 0, 75, 108,
+	0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0, 0, 0, 59, 0, 0,
+	74, 0, 0, 0, 41, 0, 44, 0, 0, 0, 0, 0, 68, 0, 0, 0,
+	0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 129, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 101, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -6, 0, 0,
+	0, 0, 0, 0, 30, 0, 0, 0, 0, 0, 0, 0, 85, 2, 0, 0,
+	0, 0, 43, 0, 0, 0, 0, 0, 56, 0, 0, 0, 0, 0, 75, 108,
+	0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0, 0, 0, 59, 82, 0,
+	0, 0, 0, 0, 41, 0, 44, 0, 0, 0, 0, 0, 68, 0, 0, 0,
+	0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0, 0, 56, 0, 0, 0,
+	0, 0, 75, 108, 0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0, 0,
+	0, 59, 83, 0, 0, 0, 0, 0, 41, 0, 44, 0, 0, 0, 0, 0,
+	68, 0, 0, 0, 0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	56, 0, 0, 0, 0, 0, 75, 108, 0, 0, 0, 0, 39, 0, 0, 0,
+	0, 0, 0, 0, 0, 59, 84, 0, 0, 0, 0, 0, 41, 0, 44, 0,
+	0, 0, 0, 0, 68, 0, 0, 0, 0, 0, 58, 0, 0, 0, 0, 0,
+	0, -42, 0, -42, 0, 0, 0, -42, -42, -42, 0, 0, 0, 0, 0, -42,
+	0, -42, -42, -42, 0, 0, 0, -42, -42, 0, 0, -42, 0, -42, -42, -42,
+	-42, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, -15, 0, -15, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, -15, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 54, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 23, 0, 0, 0, 0, 0, 3, 0, 0, 0, 16, 9, 31, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 66, 11,
+	0, 0, 0, 0, 0, 0, 0, 0, 12, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 127, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 126, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0,
+	0, 0, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 72, 0, 0, 0, 0, 0,
+	20, 0, 0, 0, 0, 0, 132, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 72, 0,
+	0, 0, 0, 0, 20, 0, 0, 0, 0, 17, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 72, 0, 0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 131, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 78, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 77, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, -40, 0, -40,
+	0, 0, 0, -40, -40, -40, 0, 0, 0, 0, 0, -40, 0, -40, -40, -40,
+	0, 0, 0, -40, -40, 0, 0, -40, 0, -40, -40, -40, -40, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, -12, 0, 0, 0, 0, 0, -12, -12, -12, 0, 0, 0,
+	-12, 0, 0, 0, 0, 0, 0, 0, 0, -12, 0, 0, -12, 0, 0, 0,
+	-12, 0, -12, 0, 0, 60, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 56, 0, 0, 0, 0, 0, 75, 108,
+	0, 0, 0, 0, 39, 0, 0, 0, 0, 0, 0, 0, 0, 59, 0, 0,
+	71, 0, 0, 0, 41, 0, 44, 0, 0, 0, 0, 0, 68, 0, 0, 0,
+	0, 0, 58, 0, 0, 0, 0, 0, 0, 0, 0, 0, -18, 0, 0, 0,
+	0, 0, -18, -18, 0, 0, 0, 0, -18, 0, 0, 0, 0, 0, 0, 0,
+	0, -18, -18, 0, -18, 0, 0, 0, -18, 0, -18, 0, 0, 0, 0, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+	-22, 0, 0, 0, 0, 0, -22, -22, 0, 0, 0, 0, -22, 0, 0, 0,
+	0, 0, 0, 0, 0, -22, -22, 0, -22, 0, 0, 0, -22, 0, -22, 0,
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+static_assert(sizeof(wlp4Actions) / sizeof(int) == wlp4NumStates * wlp4NumSymbols, "wlp4Actions needs one entry per state and symbol");
+
+#endif
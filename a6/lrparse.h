@@ -0,0 +1,205 @@
+#ifndef CS241_LRPARSE_H
+#define CS241_LRPARSE_H
+#include <vector>
+
+/* LR(1) parse driver shared by lr (A6P3) and both wlp4parse versions (A6P4,
+ * A6P5). It is templated on two policies, so each combination is compiled
+ * into its own loop with nothing looked up or called indirectly:
+ *
+ * - Actions, the table layout: anything with int action(int state, int symbol)
+ *   const returning the entries of LrTable::actions (see lrtable.h).
+ * - Builder, what the parse builds: a type with a Handle type and
+ *     Handle shift(int n, int symbol)
+ *     Handle reduce(int rule, const Handle *children, int count)
+ *   which are called as input token n is shifted and as the top count symbols
+ *   on the stack are reduced by rule; the returned handle stands for the new
+ *   symbol on the stack. LrTree builds the whole tree and LrNoTree builds
+ *   nothing. Builder is also where a consumer that wants the parse as it
+ *   happens hooks in: each reduce is a finished subtree (a procedure, say)
+ *   that it can process at once, with the events inlined into the loop.
+ *
+ * As in the .cfg format, rule 0 is the start rule, which the driver reduces
+ * itself (accept) once the whole input is shifted.
+ */
+
+// the symbols of each rule that the driver needs: the LHS symbol id and the number of RHS symbols
+struct LrRules {
+	std::vector<int> lhs;
+	std::vector<int> length;
+};
+
+template <typename Actions, typename Builder>
+class LrDriver {
+	const Actions &actions;
+	const LrRules &rules;
+	Builder &builder;
+
+	public:
+		typedef typename Builder::Handle Handle;
+
+		// the state stack, and the handles of the symbols between its states
+		std::vector<int> states;
+		std::vector<Handle> handles;
+
+		// a driver can start in any state, to parse part of the input from the middle of a parse
+		LrDriver(const Actions &actions, const LrRules &rules, Builder &builder, int start = 0)
+			: actions{actions}, rules{rules}, builder{builder}, states{start} {}
+
+		// the ACTION/GOTO entry for symbol in the current state; -1 is a symbol not in the grammar
+		int action(int symbol) const {
+			return symbol < 0 ? 0 : actions.action(states.back(), symbol);
+		}
+
+		// reduce the top of the stacks by rule
+		void reduceBy(int rule) {
+			int count = rules.length[rule];
+			Handle parent = builder.reduce(rule, handles.data() + handles.size() - count, count);
+			states.resize(states.size() - count);
+			handles.resize(handles.size() - count);
+			handles.push_back(parent);
+			// the GOTO entry for the rule's LHS always exists
+			states.push_back(action(rules.lhs[rule]) - 1);
+		}
+
+		// perform the reductions the stacks call for with lookahead symbol
+		// returns the ACTION entry left for symbol: the shift (state + 1), or 0 if symbol is rejected
+		int reduceOn(int symbol) {
+			int act = action(symbol);
+			for (; act < 0; act = action(symbol)) {
+				// a driver started in the middle of a parse can't reduce below its first state
+				if (rules.length[-act - 1] >= static_cast<int>(states.size())) {
+					return 0;
+				}
+				reduceBy(-act - 1);
+			}
+			return act;
+		}
+
+		// push a symbol with handle h, where act is its entry from reduceOn
+		void push(Handle h, int act) {
+			handles.push_back(h);
+			states.push_back(act - 1);
+		}
+
+		// shift input token n, with grammar symbol id symbol, after the reductions it calls for
+		// returns false if it is rejected
+		bool shift(int n, int symbol) {
+			int act = reduceOn(symbol);
+			if (act == 0) {
+				return false;
+			}
+			push(builder.shift(n, symbol), act);
+			return true;
+		}
+
+		// reduce the whole stack by rule 0, returns false if it doesn't hold the start rule's RHS
+		bool accept() {
+			if (handles.size() != static_cast<size_t>(rules.length[0])) {
+				return false;
+			}
+			builder.reduce(0, handles.data(), handles.size());
+			return true;
+		}
+};
+
+// function to make a driver without spelling out its policies
+template <typename Actions, typename Builder>
+LrDriver<Actions, Builder> makeLrDriver(const Actions &actions, const LrRules &rules, Builder &builder, int start = 0) {
+	return LrDriver<Actions, Builder>(actions, rules, builder, start);
+}
+
+/* Parses the input tokens[0, count), given by grammar symbol id, from state 0.
+ * Returns -1 if the input is accepted, or else the number of tokens shifted
+ * before the error (count if all of them were, but the start rule can't be
+ * reduced).
+ */
+template <typename Actions, typename Builder>
+int lrParse(const Actions &actions, const LrRules &rules, Builder &builder, const int *tokens, int count) {
+	auto driver = makeLrDriver(actions, rules, builder);
+	for (int i = 0; i < count; ++i) {
+		if (!driver.shift(i, tokens[i])) {
+			return i;
+		}
+	}
+	return driver.accept() ? -1 : count;
+}
+
+// a node of an LrTree: the rule it was reduced by, and its children, which are the handles
+// children[first, first + count) of the tree
+struct LrNode {
+	int rule;
+	int first;
+	int count;
+};
+
+// builder that keeps the whole parse tree, with the non-terminals in an arena so that reductions
+// never copy subtrees. The handle of a non-terminal is its index in the arena, and the handle of the
+// leaf for input token n is ~n, since the parser already holds the input.
+class LrTree {
+	protected:
+		std::vector<LrNode> nodes;
+		std::vector<int> children;
+
+	public:
+		typedef int Handle;
+
+		int shift(int n, int) {
+			return ~n;
+		}
+
+		int reduce(int rule, const int *first, int count) {
+			nodes.push_back(LrNode{rule, static_cast<int>(children.size()), count});
+			children.insert(children.end(), first, first + count);
+			return nodes.size() - 1;
+		}
+
+		// the root is the node of the final reduction
+		int root() const {
+			return nodes.size() - 1;
+		}
+
+		const LrNode &node(int h) const {
+			return nodes[h];
+		}
+
+		// handle of child i of node
+		int child(const LrNode &node, int i) const {
+			return children[node.first + i];
+		}
+
+		// function to move the nodes of other to the end of this tree
+		// returns the amount added to the handles of other's non-terminals
+		int append(LrTree &other) {
+			int nodeOffset = nodes.size();
+			int childOffset = children.size();
+			for (LrNode node : other.nodes) {
+				node.first += childOffset;
+				nodes.push_back(node);
+			}
+			for (int c : other.children) {
+				children.push_back(c < 0 ? c : c + nodeOffset);
+			}
+			other.clear();
+			return nodeOffset;
+		}
+
+		// function to remove every node
+		void clear() {
+			std::vector<LrNode>().swap(nodes);
+			std::vector<int>().swap(children);
+		}
+};
+
+// builder that builds nothing, for a parse that only checks the input
+struct LrNoTree {
+	typedef int Handle;
+
+	int shift(int, int) {
+		return 0;
+	}
+
+	int reduce(int, const int *, int) {
+		return 0;
+	}
+};
+#endif
@@ -0,0 +1,511 @@
+#ifndef CS241_LRTABLE_H
+#define CS241_LRTABLE_H
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+#include "lrparse.h"
+
+/* A grammar together with its LR parse table in dense form: the ACTION/GOTO
+ * entry for (state, symbol) is actions[state * symbols.size() + symbol],
+ * where 0 is an error, s + 1 shifts to (or, for a non-terminal, goes to)
+ * state s, and -(r + 1) reduces by rule r. Symbols are numbered terminals
+ * first. Rule r is ruleSymbols[ruleOffsets[r], ruleOffsets[r + 1]), with its
+ * LHS first. As in the .cfg format, rule 0 is the start rule, which the
+ * parser reduces itself once the whole input is shifted. readCfg loads one
+ * from the .cfg format, for lr, both wlp4parse versions and cfg2header.
+ *
+ * lrgen writes tables in the binary layout below (lrgen --binary), and
+ * wlp4parse -g reads them as well as .cfg files. All integers are 32-bit,
+ * host byte order:
+ *
+ *   char     magic[8]                    LR_TABLE_MAGIC
+ *   uint32   numSymbols, numTerminals, startSymbol, numRules, numStates,
+ *            ruleSymbolCount, nameBytes
+ *   char     names[nameBytes]            symbol names, each one NUL terminated
+ *   int32    ruleOffsets[numRules + 1]
+ *   int32    ruleSymbols[ruleSymbolCount]
+ *   int32    actions[numStates * numSymbols]
+ */
+
+const char LR_TABLE_MAGIC[8] = {'\x7f', 'W', 'L', 'P', '4', 'L', 'R', '1'};
+
+struct LrTable {
+	std::vector<std::string> symbols;
+	int numTerminals = 0;
+	int startSymbol = 0;
+	std::vector<int> ruleOffsets{0};
+	std::vector<int> ruleSymbols;
+	int numStates = 0;
+	std::vector<int> actions;
+
+	int numRules() const { return ruleOffsets.size() - 1; }
+};
+
+inline void writeLrTable(std::ostream &out, const LrTable &table) {
+	std::string names;
+	for (auto &s : table.symbols) {
+		names += s;
+		names += '\0';
+	}
+	uint32_t header[7] = {
+		static_cast<uint32_t>(table.symbols.size()), static_cast<uint32_t>(table.numTerminals),
+		static_cast<uint32_t>(table.startSymbol), static_cast<uint32_t>(table.numRules()),
+		static_cast<uint32_t>(table.numStates), static_cast<uint32_t>(table.ruleSymbols.size()),
+		static_cast<uint32_t>(names.size())
+	};
+	out.write(LR_TABLE_MAGIC, sizeof(LR_TABLE_MAGIC));
+	out.write(reinterpret_cast<const char *>(header), sizeof(header));
+	out.write(names.data(), names.size());
+	out.write(reinterpret_cast<const char *>(table.ruleOffsets.data()), table.ruleOffsets.size() * sizeof(int32_t));
+	out.write(reinterpret_cast<const char *>(table.ruleSymbols.data()), table.ruleSymbols.size() * sizeof(int32_t));
+	out.write(reinterpret_cast<const char *>(table.actions.data()), table.actions.size() * sizeof(int32_t));
+}
+
+// Returns true if the stream starts with LR_TABLE_MAGIC, without consuming anything
+inline bool isLrTable(std::istream &in) {
+	char magic[sizeof(LR_TABLE_MAGIC)];
+	std::streampos start = in.tellg();
+	bool result = static_cast<bool>(in.read(magic, sizeof(magic)))
+								&& std::memcmp(magic, LR_TABLE_MAGIC, sizeof(magic)) == 0;
+	in.clear();
+	in.seekg(start);
+	return result;
+}
+
+/* Reads a table written by writeLrTable. Returns false with a message in
+ * error if the input is not a well-formed table.
+ */
+inline bool readLrTable(std::istream &in, LrTable &table, std::string &error) {
+	char magic[sizeof(LR_TABLE_MAGIC)];
+	uint32_t header[7];
+	if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, LR_TABLE_MAGIC, sizeof(magic)) != 0
+			|| !in.read(reinterpret_cast<char *>(header), sizeof(header))) {
+		error = "ERROR: Input is not a binary LR table";
+		return false;
+	}
+	uint32_t numSymbols = header[0];
+	uint64_t tableSize = uint64_t(header[4]) * numSymbols;
+	if (header[1] > numSymbols || header[2] >= numSymbols || header[3] == 0
+			|| tableSize > (1u << 30) || header[5] > (1u << 30) || header[6] > (1u << 30)) {
+		error = "ERROR: Corrupt binary LR table";
+		return false;
+	}
+
+	std::string names(header[6], '\0');
+	table.ruleOffsets.assign(header[3] + 1, 0);
+	table.ruleSymbols.assign(header[5], 0);
+	table.actions.assign(tableSize, 0);
+	if (!in.read(&names[0], names.size())
+			|| !in.read(reinterpret_cast<char *>(table.ruleOffsets.data()), table.ruleOffsets.size() * sizeof(int32_t))
+			|| !in.read(reinterpret_cast<char *>(table.ruleSymbols.data()), table.ruleSymbols.size() * sizeof(int32_t))
+			|| !in.read(reinterpret_cast<char *>(table.actions.data()), table.actions.size() * sizeof(int32_t))) {
+		error = "ERROR: Truncated binary LR table";
+		return false;
+	}
+
+	table.symbols.clear();
+	for (size_t start = 0; start < names.size();) {
+		size_t end = names.find('\0', start);
+		if (end == std::string::npos) {
+			break;
+		}
+		table.symbols.push_back(names.substr(start, end - start));
+		start = end + 1;
+	}
+	table.numTerminals = header[1];
+	table.startSymbol = header[2];
+	table.numStates = header[4];
+
+	// check every index so that a parser can use the table without bounds checks
+	bool valid = table.symbols.size() == numSymbols && table.ruleOffsets[0] == 0
+							 && table.ruleOffsets.back() == static_cast<int>(table.ruleSymbols.size());
+	for (int r = 0; valid && r < table.numRules(); ++r) {
+		valid = table.ruleOffsets[r] < table.ruleOffsets[r + 1];
+	}
+	for (int s : table.ruleSymbols) {
+		valid = valid && s >= 0 && s < static_cast<int>(numSymbols);
+	}
+	for (int a : table.actions) {
+		valid = valid && (a > 0 ? a <= table.numStates : -a <= table.numRules());
+	}
+	if (!valid) {
+		error = "ERROR: Corrupt binary LR table";
+		return false;
+	}
+	return true;
+}
+
+/* A loaded table together with what a parser looks up in it: the id of each symbol by name, and the
+ * LHS and RHS length of each rule (see lrparse.h). index() fills them in from the table.
+ */
+struct LrGrammar : LrTable {
+	std::unordered_map<std::string, int> symbolIds;
+	LrRules rules;
+
+	// function to index the symbols and rules of the table (a repeated symbol name keeps its first id)
+	void index() {
+		symbolIds.clear();
+		for (int s = 0; s < static_cast<int>(symbols.size()); ++s) {
+			symbolIds.emplace(symbols[s], s);
+		}
+		rules.lhs.clear();
+		rules.length.clear();
+		for (int r = 0; r < numRules(); ++r) {
+			rules.lhs.push_back(ruleSymbols[ruleOffsets[r]]);
+			rules.length.push_back(ruleOffsets[r + 1] - ruleOffsets[r] - 1);
+		}
+	}
+
+	// return the id of symbol s, or -1 if s is not in the grammar
+	int symbolId(const std::string &s) const {
+		auto it = symbolIds.find(s);
+		return it == symbolIds.end() ? -1 : it->second;
+	}
+
+	// return true if symbol id s (or the symbol named s) is a terminal
+	bool isTerminal(int s) const {
+		return s >= 0 && s < numTerminals;
+	}
+	bool isTerminal(const std::string &s) const {
+		return isTerminal(symbolId(s));
+	}
+};
+
+/* Reads a grammar and its parse table in the .cfg format: the terminals, the non-terminals and the
+ * start symbol, the rules one per line (LHS first), the number of states, and the shift and reduce
+ * actions as "state symbol shift|reduce n". An action for a state or symbol not in the table is
+ * ignored. The stream is left just after the last action, so input that follows the table can be
+ * read from it. Returns false with a message in error if the grammar is malformed.
+ */
+inline bool readCfg(std::istream &in, LrGrammar &grammar, std::string &error) {
+	grammar = LrGrammar();
+	int counter = 0;
+	std::string symbol;
+
+	// read and intern terminals, then non-terminals (a repeated symbol keeps its first id)
+	for (int list = 0; list < 2; ++list) {
+		in >> counter;
+		for (int i = 0; i < counter; ++i) {
+			in >> symbol;
+			if (grammar.symbolIds.emplace(symbol, grammar.symbols.size()).second) {
+				grammar.symbols.push_back(symbol);
+			}
+		}
+		if (list == 0) {
+			grammar.numTerminals = grammar.symbols.size();
+		}
+	}
+
+	std::string start;
+	in >> start;
+	grammar.startSymbol = grammar.symbolId(start);
+	if (!in || grammar.startSymbol == -1) {
+		error = "ERROR: Missing or unknown start symbol";
+		return false;
+	}
+
+	// read production rules, one per line
+	counter = 0;
+	in >> counter;
+	std::string line;
+	std::getline(in, line); // move to next line
+	for (int i = 0; i < counter; ++i) {
+		std::getline(in, line);
+		std::stringstream ss{line};
+		while (ss >> symbol) {
+			int id = grammar.symbolId(symbol);
+			if (id == -1) {
+				error = "ERROR: Unknown symbol " + symbol + " in rule " + std::to_string(i);
+				return false;
+			}
+			grammar.ruleSymbols.push_back(id);
+		}
+		if (grammar.ruleSymbols.size() == static_cast<size_t>(grammar.ruleOffsets.back())) {
+			error = "ERROR: Empty rule " + std::to_string(i);
+			return false;
+		}
+		grammar.ruleOffsets.push_back(grammar.ruleSymbols.size());
+	}
+
+	// read the shift and reduce actions into the dense table
+	counter = 0;
+	in >> grammar.numStates >> counter;
+	if (!in || grammar.numStates <= 0) {
+		error = "ERROR: Missing parse table";
+		return false;
+	}
+	int numSymbols = grammar.symbols.size();
+	grammar.actions.assign(size_t(grammar.numStates) * numSymbols, 0);
+	int state;
+	std::string lookahead;
+	std::string check;
+	int move;
+	for (int i = 0; i < counter; ++i) {
+		if (!(in >> state >> lookahead >> check >> move)) {
+			error = "ERROR: Truncated parse table";
+			return false;
+		}
+		int id = grammar.symbolId(lookahead);
+		if (state < 0 || state >= grammar.numStates || id == -1) {
+			continue;
+		}
+		int &entry = grammar.actions[state * numSymbols + id];
+		if (check == "shift" && entry >= 0) {
+			entry = move + 1;
+		}
+		else if (check == "reduce") {
+			// a reduction takes precedence over a shift on the same lookahead
+			entry = -(move + 1);
+		}
+	}
+	grammar.index();
+	return true;
+}
+
+/* The ACTION/GOTO entries of a table can be kept in one of three layouts, chosen when the table is
+ * loaded (wlp4parse and lr take --table dense|comb|map). Each one is built from the dense entries
+ * of LrTable::actions and returns the same entries from action(state, symbol), except as noted for
+ * CombActions. bytes() is the memory the layout takes.
+ */
+enum LrLayout { LR_DENSE, LR_COMB, LR_MAP };
+
+// function to look up a layout by its name (dense, comb or map)
+inline bool lrLayoutFromName(const std::string &name, LrLayout &layout) {
+	if (name == "dense") {
+		layout = LR_DENSE;
+	}
+	else if (name == "comb") {
+		layout = LR_COMB;
+	}
+	else if (name == "map") {
+		layout = LR_MAP;
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+// one entry per (state, symbol): the fastest lookup, but states * symbols entries
+struct DenseActions {
+	int numSymbols = 0;
+	std::vector<int> entries;
+
+	DenseActions() {}
+	DenseActions(std::vector<int> actions, int numStates, int symbols) : numSymbols{symbols}, entries{std::move(actions)} {
+		entries.resize(size_t(numStates) * numSymbols);
+	}
+
+	int action(int state, int symbol) const {
+		return entries[state * numSymbols + symbol];
+	}
+
+	size_t bytes() const {
+		return entries.size() * sizeof(int);
+	}
+};
+
+/* Row displacement (comb vector) packing. Each state's most common reduction becomes its default,
+ * which also replaces its error entries on terminals, and the remaining entries of every row are
+ * overlaid in one vector at an offset chosen so that no two rows use the same slot: the entry for
+ * (state, symbol) is next[base[state] + symbol] if check[] of that slot is state, and
+ * defaults[state] otherwise. As with yacc's default reductions, an input error can be found after
+ * some extra reductions, but always before the erroneous token is shifted. GOTO entries are never
+ * defaulted, and a missing one is 0 (or the state's default reduction).
+ */
+struct CombActions {
+	std::vector<int> defaults;
+	std::vector<int> base;
+	std::vector<int> next;
+	std::vector<int> check;
+
+	CombActions() {}
+	CombActions(const std::vector<int> &actions, int numStates, int numSymbols, int numTerminals) {
+		defaults.assign(numStates, 0);
+		base.assign(numStates, 0);
+
+		// the entries each row keeps, as column positions into actions
+		std::vector<std::vector<int>> rows(numStates);
+		for (int s = 0; s < numStates; ++s) {
+			const int *row = &actions[size_t(s) * numSymbols];
+			std::map<int, int> counts;
+			for (int x = 0; x < numTerminals; ++x) {
+				if (row[x] < 0) {
+					++counts[row[x]];
+				}
+			}
+			int best = 0;
+			for (auto &c : counts) {
+				if (best == 0 || c.second > counts[best]) {
+					best = c.first;
+				}
+			}
+			defaults[s] = best;
+			for (int x = 0; x < numSymbols; ++x) {
+				if (row[x] != 0 && !(x < numTerminals && row[x] == best)) {
+					rows[s].push_back(x);
+				}
+			}
+		}
+
+		// place the fullest rows first, each at the lowest offset where it fits
+		std::vector<int> order(numStates);
+		for (int s = 0; s < numStates; ++s) {
+			order[s] = s;
+		}
+		std::stable_sort(order.begin(), order.end(), [&rows](int a, int b) { return rows[a].size() > rows[b].size(); });
+		// used has a bit set for each slot of check that is taken, so that 64 offsets can be tried at once
+		std::vector<uint64_t> used;
+		auto usedBits = [&used](size_t p) {
+			size_t w = p / 64;
+			uint64_t low = w < used.size() ? used[w] >> (p % 64) : 0;
+			uint64_t high = p % 64 != 0 && w + 1 < used.size() ? used[w + 1] << (64 - p % 64) : 0;
+			return low | high;
+		};
+		int firstFree = 0;
+		for (int s : order) {
+			if (rows[s].empty()) {
+				continue;
+			}
+			int offset = std::max(0, firstFree - rows[s][0]);
+			for (;; offset += 64) {
+				// bit i of taken is set if the row can't go at offset + i
+				uint64_t taken = 0;
+				for (int x : rows[s]) {
+					taken |= usedBits(offset + x);
+					if (taken == ~uint64_t(0)) {
+						break;
+					}
+				}
+				if (taken != ~uint64_t(0)) {
+					offset += __builtin_ctzll(~taken);
+					break;
+				}
+			}
+			base[s] = offset;
+			if (check.size() < size_t(offset + numSymbols)) {
+				next.resize(offset + numSymbols, 0);
+				check.resize(offset + numSymbols, -1);
+				used.resize(check.size() / 64 + 1, 0);
+			}
+			for (int x : rows[s]) {
+				next[offset + x] = actions[size_t(s) * numSymbols + x];
+				check[offset + x] = s;
+				used[(offset + x) / 64] |= uint64_t(1) << ((offset + x) % 64);
+			}
+			while (firstFree < int(check.size()) && check[firstFree] != -1) {
+				++firstFree;
+			}
+		}
+		// every state's row must lie inside the vectors, even one with no entries
+		int top = 0;
+		for (int s = 0; s < numStates; ++s) {
+			top = std::max(top, base[s] + numSymbols);
+		}
+		next.resize(top, 0);
+		check.resize(top, -1);
+	}
+
+	int action(int state, int symbol) const {
+		int i = base[state] + symbol;
+		return check[i] == state ? next[i] : defaults[state];
+	}
+
+	size_t bytes() const {
+		return (defaults.size() + base.size() + next.size() + check.size()) * sizeof(int);
+	}
+};
+
+// the entries that aren't errors in a std::map, the way the original parsers stored them
+struct MapActions {
+	std::map<std::pair<int, int>, int> entries;
+
+	MapActions() {}
+	MapActions(const std::vector<int> &actions, int numStates, int numSymbols) {
+		for (int s = 0; s < numStates; ++s) {
+			for (int x = 0; x < numSymbols; ++x) {
+				if (actions[size_t(s) * numSymbols + x] != 0) {
+					entries.emplace_hint(entries.end(), std::make_pair(s, x), actions[size_t(s) * numSymbols + x]);
+				}
+			}
+		}
+	}
+
+	int action(int state, int symbol) const {
+		auto it = entries.find(std::make_pair(state, symbol));
+		return it == entries.end() ? 0 : it->second;
+	}
+
+	// each entry is a red-black tree node: three pointers and a color, then the key and value
+	size_t bytes() const {
+		return entries.size() * (4 * sizeof(void *) + sizeof(std::pair<const std::pair<int, int>, int>));
+	}
+};
+
+// the table in whichever layout was chosen when it was built; action switches on the layout each time
+class LrActions {
+	LrLayout layout = LR_DENSE;
+	DenseActions dense;
+	CombActions comb;
+	MapActions sparse;
+
+	public:
+		LrActions() {}
+		LrActions(LrLayout layout, std::vector<int> actions, int numStates, int numSymbols, int numTerminals)
+			: layout{layout} {
+			if (layout == LR_COMB) {
+				comb = CombActions(actions, numStates, numSymbols, numTerminals);
+			}
+			else if (layout == LR_MAP) {
+				sparse = MapActions(actions, numStates, numSymbols);
+			}
+			else {
+				dense = DenseActions(std::move(actions), numStates, numSymbols);
+			}
+		}
+
+		int action(int state, int symbol) const {
+			switch (layout) {
+				case LR_COMB:
+					return comb.action(state, symbol);
+				case LR_MAP:
+					return sparse.action(state, symbol);
+				default:
+					return dense.action(state, symbol);
+			}
+		}
+
+		size_t bytes() const {
+			return layout == LR_COMB ? comb.bytes() : layout == LR_MAP ? sparse.bytes() : dense.bytes();
+		}
+
+		// function to call f with the layout in use, so that a driver templated on the layout (see
+		// lrparse.h) looks entries up directly instead of through action
+		template <typename F>
+		auto visit(F f) const -> decltype(f(std::declval<const DenseActions &>())) {
+			switch (layout) {
+				case LR_COMB:
+					return f(comb);
+				case LR_MAP:
+					return f(sparse);
+				default:
+					return f(dense);
+			}
+		}
+};
+
+// function to pack the ACTION/GOTO entries of table into layout, leaving table.actions empty
+inline LrActions packActions(LrTable &table, LrLayout layout) {
+	LrActions packed(layout, std::move(table.actions), table.numStates, table.symbols.size(), table.numTerminals);
+	std::vector<int>().swap(table.actions);
+	return packed;
+}
+#endif
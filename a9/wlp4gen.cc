@@ -5,43 +5,167 @@
 #include <algorithm>
 #include <sstream>
 #include <map>
+#include <unordered_map>
+#include <chrono>
+#include "../a5/A5P1/intern.h"
+#include "../a6/A6P5/treefile.h"
+#include "../a6/A6P5/wlp4table.h"
 
 using namespace std;
 
-// vector for storing terminals
-vector<string> terminals{"BOF", "BECOMES", "COMMA", "ELSE", "EOF", "EQ", "GE", "GT", "ID", "IF", "INT", "LBRACE", "LE", "LPAREN", "LT", "MINUS", "NE", "NUM", "PCT", "PLUS", "PRINTLN", "RBRACE", "RETURN", "RPAREN", "SEMI", "SLASH", "STAR", "WAIN", "WHILE", "AMP", "LBRACK", "RBRACK", "NEW", "DELETE", "NULL"};
+// The passes below dispatch on the rule id of each node, the index of its rule in the WLP4 grammar
+// compiled in from wlp4table.h, instead of comparing rule strings. wlp4Rule and wlp4Symbol look the
+// ids up at compile time, so a case label that names no rule or symbol doesn't compile.
 
-// top symbol table
-map<string, pair<vector<string>, map<string, string>>> tables;
+// function to match symbol name against the start of text, returns the length matched or -1
+constexpr int matchName(const char *text, const char *name) {
+	int i = 0;
+	for (; name[i] != '\0'; ++i) {
+		if (text[i] != name[i]) {
+			return -1;
+		}
+	}
+	return i;
+}
 
-// current procedure being traversed
-string procedure = "";
+// id of the WLP4 symbol name
+constexpr int wlp4Symbol(const char *name) {
+	for (int s = 0; s < wlp4NumSymbols; ++s) {
+		int n = matchName(name, wlp4Symbols[s]);
+		if (n >= 0 && name[n] == '\0') {
+			return s;
+		}
+	}
+	throw "ERROR: Not a WLP4 symbol";
+}
 
-// class for storing each node in our traversal tree
-class Tree {
-	public:
+// id of the WLP4 rule written as in the .wlp4i text, "LHS RHS..." with single spaces
+constexpr int wlp4Rule(const char *text) {
+	for (int r = 0; r < wlp4NumRules; ++r) {
+		const char *t = text;
+		bool match = true;
+		for (int i = wlp4RuleOffsets[r]; match && i < wlp4RuleOffsets[r + 1]; ++i) {
+			if (i > wlp4RuleOffsets[r]) {
+				match = *t++ == ' ';
+			}
+			int n = match ? matchName(t, wlp4Symbols[wlp4RuleSymbols[i]]) : -1;
+			match = n >= 0;
+			t += match ? n : 0;
+		}
+		if (match && *t == '\0') {
+			return r;
+		}
+	}
+	throw "ERROR: Not a WLP4 rule";
+}
+
+// the ids of the rules and symbols that are looked up outside case labels
+constexpr int ID_SYMBOL = wlp4Symbol("ID");
+constexpr int TYPE_INT = wlp4Rule("type INT");
+constexpr int TYPE_INT_STAR = wlp4Rule("type INT STAR");
+constexpr int LVALUE_ID = wlp4Rule("lvalue ID");
+constexpr int LVALUE_STAR = wlp4Rule("lvalue STAR factor");
+constexpr int LVALUE_PARENS = wlp4Rule("lvalue LPAREN lvalue RPAREN");
+constexpr int PARAMLIST_MORE = wlp4Rule("paramlist dcl COMMA paramlist");
+constexpr int ARGLIST_MORE = wlp4Rule("arglist expr COMMA arglist");
+
+// rule and symbol ids by their text, for reading the rules of a parse tree
+unordered_map<string, int> ruleIds;
+unordered_map<string, int> symbolIds;
+
+// function to fill ruleIds and symbolIds from the grammar
+void internGrammar() {
+	for (int s = 0; s < wlp4NumSymbols; ++s) {
+		symbolIds.emplace(wlp4Symbols[s], s);
+	}
+	for (int r = 0; r < wlp4NumRules; ++r) {
 		string rule;
-		string LHS;
-		string lexeme; // only for terminals
+		for (int i = wlp4RuleOffsets[r]; i < wlp4RuleOffsets[r + 1]; ++i) {
+			rule += (i == wlp4RuleOffsets[r] ? "" : " ") + string(wlp4Symbols[wlp4RuleSymbols[i]]);
+		}
+		ruleIds.emplace(rule, r);
+	}
+}
+
+// function to return the id of s in ids, or -1 if it isn't there
+int lookup(const unordered_map<string, int> &ids, const string &s) {
+	auto it = ids.find(s);
+	return it == ids.end() ? -1 : it->second;
+}
+
+// identifiers in the program, numbered in order of first appearance (the same ids wlp4scan assigns)
+InternTable identifiers;
+
+// id of the procedure name "wain", which is a keyword rather than an identifier
+int wain;
+
+// class for storing a variable declared in a procedure
+class Variable {
+	public:
+		int id;
 		string type;
-		vector<unique_ptr<Tree>> children;
+		int offset = 0; // offset from $29, assigned during code generation
 
-		Tree(string rule) : rule{rule} {}
+		Variable(int id, string type) : id{id}, type{type} {}
 };
 
+// class for storing the symbol table of a procedure
+class Procedure {
+	public:
+		bool declared = false;
+		vector<string> signature;
+		vector<Variable> variables;
+};
 
-// determine if "w" is a terminal or not
-bool isTerminal(string w) {
-	
-	auto it = find (terminals.begin(), terminals.end(), w);
+// top symbol table, indexed by the identifier id of the procedure name
+vector<Procedure> tables;
 
-	if (it != terminals.end()) {
-		return true;
+// index in the current procedure's variables of each identifier id, or -1 if not declared there
+vector<int> scope;
+
+// current procedure being traversed (identifier id of its name)
+int procedure = -1;
+
+// make p the current procedure, so that its variables can be found through scope
+void enter(int p) {
+	if (procedure != -1) {
+		for (auto &v : tables[procedure].variables) {
+			scope[v.id] = -1;
+		}
+	}
+	procedure = p;
+	for (size_t i = 0; i < tables[p].variables.size(); ++i) {
+		scope[tables[p].variables[i].id] = i;
 	}
+}
 
-	return false;
+// return variable "id" of the current procedure, or nullptr if it has not been declared
+Variable *variable(int id) {
+	if (scope[id] == -1) {
+		return nullptr;
+	}
+	return &tables[procedure].variables[scope[id]];
 }
 
+// declare variable "id" in the current procedure
+void declare(int id, string type) {
+	scope[id] = tables[procedure].variables.size();
+	tables[procedure].variables.push_back(Variable{id, type});
+}
+
+// class for storing each node in our traversal tree
+class Tree {
+	public:
+		int rule; // rule id, -1 for a terminal (or a rule not in the WLP4 grammar)
+		int symbol; // symbol id of the LHS, or of the terminal (-1 if not in the WLP4 grammar)
+		string lexeme; // only for terminals
+		int id = -1; // interned id of the lexeme, only for ID terminals
+		string type;
+		vector<unique_ptr<Tree>> children;
+
+		Tree(int rule, int symbol) : rule{rule}, symbol{symbol} {}
+};
+
 
 // read in data and create traversal tree
 std::unique_ptr<Tree> read() {
@@ -49,15 +173,19 @@ std::unique_ptr<Tree> read() {
 	// initialize node with rule
 	string rule;
 	getline(cin, rule);
-	auto tree = make_unique<Tree>(rule);
 
 	// read in lexeme and children
 	istringstream ss{rule};
 	string LHS;
 	ss >> LHS;
-	tree->LHS = LHS;
-	if (isTerminal(LHS)) {
+	int symbol = lookup(symbolIds, LHS);
+	bool terminal = symbol != -1 && symbol < wlp4NumTerminals;
+	auto tree = make_unique<Tree>(terminal ? -1 : lookup(ruleIds, rule), symbol);
+	if (terminal) {
 		ss >> tree->lexeme;
+		if (symbol == ID_SYMBOL) {
+			tree->id = identifiers.intern(tree->lexeme);
+		}
 	}
 	else {
 		string curr;
@@ -70,6 +198,64 @@ std::unique_ptr<Tree> read() {
 }
 
 
+// class for building the traversal tree from a binary parse tree written by "wlp4parse --binary-tree"
+// the ids of each rule and symbol and the strings of each lexeme are made once, instead of being parsed
+// from every line, and the identifiers keep the ids wlp4scan interned them with (see treefile.h)
+class BinaryReader {
+	const TreeFile &file;
+	vector<int> rules; // the id of each rule of the file
+	vector<int> symbols; // the id of each symbol of the file
+	vector<string> lexemes;
+	uint32_t next = 0; // next node of the file in preorder
+
+	public:
+		BinaryReader(const TreeFile &file) : file{file} {
+			for (uint32_t s = 0; s < file.symbolCount(); ++s) {
+				symbols.push_back(lookup(symbolIds, file.symbol(s)));
+			}
+			for (uint32_t r = 0; r < file.ruleCount(); ++r) {
+				string rule = file.symbol(file.ruleSymbol(r, 0));
+				for (uint32_t i = 1; i < file.ruleLength(r); ++i) {
+					rule += " " + file.symbol(file.ruleSymbol(r, i));
+				}
+				rules.push_back(lookup(ruleIds, rule));
+			}
+			for (uint32_t i = 0; i < file.lexemeCount(); ++i) {
+				lexemes.push_back(file.lexeme(i));
+			}
+			for (uint32_t i = 0; i < file.identifierCount(); ++i) {
+				identifiers.intern(lexemes[i]);
+			}
+		}
+
+		// returns false if an identifier is listed twice, so that ids would not be its lexeme indices
+		bool valid() const {
+			return static_cast<uint32_t>(identifiers.size()) == file.identifierCount();
+		}
+
+		// create the traversal tree of the next node and its subtree, like read()
+		// the lexeme index of an ID leaf is its identifier id
+		std::unique_ptr<Tree> read() {
+			const TreeFileNode &node = file.node(next++);
+			unique_ptr<Tree> tree;
+			if (node.rule < 0) {
+				tree = make_unique<Tree>(-1, symbols[~node.rule]);
+				tree->lexeme = lexemes[node.value];
+				if (tree->symbol == ID_SYMBOL) {
+					tree->id = node.value;
+				}
+			}
+			else {
+				tree = make_unique<Tree>(rules[node.rule], symbols[file.ruleSymbol(node.rule, 0)]);
+				for (uint32_t i = 0; i < node.value; ++i) {
+					tree->children.push_back(read());
+				}
+			}
+			return tree;
+		}
+};
+
+
 // build our symbol table and check variable and procedure use
 bool build(const Tree *t) {
 
@@ -78,81 +264,91 @@ bool build(const Tree *t) {
 
 	for (auto &child : t->children) {
 
-		// wain function
-		if (child->rule == "main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE") {
-			if (tables.count("wain")) {
-				cerr << "ERROR: Multiple wain declarations" << endl;
-				error = true;
-			}
-			else {
-				procedure = "wain";
-				// check type of arguments, and input into tables map
-				for (int i = 0; i <= 2; i += 2) {
-					if (child->children[i+3]->children[0]->rule == "type INT STAR") {
-						tables[procedure].first.push_back("int*");
-					}
-					else {
-						tables[procedure].first.push_back("int");
+		switch (child->rule) {
+			// wain function
+			case wlp4Rule("main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE"):
+				if (tables[wain].declared) {
+					cerr << "ERROR: Multiple wain declarations" << endl;
+					error = true;
+				}
+				else {
+					tables[wain].declared = true;
+					enter(wain);
+					// check type of arguments, and input into tables
+					for (int i = 0; i <= 2; i += 2) {
+						if (child->children[i+3]->children[0]->rule == TYPE_INT_STAR) {
+							tables[procedure].signature.push_back("int*");
+						}
+						else {
+							tables[procedure].signature.push_back("int");
+						}
 					}
 				}
-			}
-		}
+				break;
 
-		// check on variable usage => if it has been declared or not
-		else if (child->rule == "factor ID" || child->rule == "lvalue ID") {
-			string lex = child->children[0]->lexeme;
-			if (!tables[procedure].second.count(lex)) {
-				cerr << "ERROR: Variable not declared" << endl;
-				error = true;
+			// check on variable usage => if it has been declared or not
+			case wlp4Rule("factor ID"):
+			case wlp4Rule("lvalue ID"): {
+				int id = child->children[0]->id;
+				if (!variable(id)) {
+					cerr << "ERROR: Variable not declared" << endl;
+					error = true;
+				}
+				break;
 			}
-		}
 
-		// variable declaration
-		else if (child->rule == "dcl type ID") {
-			string lex = child->children[1]->lexeme;
-			if (tables[procedure].second.count(lex)) {
-				cerr << "ERROR: Duplicate variable declarations" << endl;
-				error = true;
-			}
-			else {
-				if (child->children[0]->rule == "type INT STAR") {
-					tables[procedure].second[lex] = "int*";
+			// variable declaration
+			case wlp4Rule("dcl type ID"): {
+				int id = child->children[1]->id;
+				if (variable(id)) {
+					cerr << "ERROR: Duplicate variable declarations" << endl;
+					error = true;
 				}
 				else {
-					tables[procedure].second[lex] = "int";
+					if (child->children[0]->rule == TYPE_INT_STAR) {
+						declare(id, "int*");
+					}
+					else {
+						declare(id, "int");
+					}
 				}
+				break;
 			}
-		}
-
-		// new procedure declaration
-		else if (child->rule == "procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE") {
-			string lex = child->children[1]->lexeme;
-			if (tables.count(lex)) {
-				cerr << "ERROR: Duplicate procedure declarations" << endl;
-				error = true;
-			}
-			procedure = lex;
 
-			// initialize new entry in tables map
-			tables[lex];
-		}
+			// new procedure declaration
+			case wlp4Rule("procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE"): {
+				int id = child->children[1]->id;
+				if (tables[id].declared) {
+					cerr << "ERROR: Duplicate procedure declarations" << endl;
+					error = true;
+				}
 
-		// determine signatures on any procedures
-		else if (child->rule == "paramlist dcl" || child->rule == "paramlist dcl COMMA paramlist") {
-			if (child->children[0]->children[0]->rule == "type INT STAR") {
-				tables[procedure].first.push_back("int*");
-			}
-			else {
-				tables[procedure].first.push_back("int");
+				// initialize new entry in tables
+				tables[id].declared = true;
+				enter(id);
+				break;
 			}
-		}
 
-		// check procedure calls
-		else if (child->rule == "factor ID LPAREN RPAREN" || child->rule == "factor ID LPAREN arglist RPAREN") {
-			string lex = child->children[0]->lexeme;
-			if (!tables.count(lex) || tables[procedure].second.count(lex)) {
-				cerr << "ERROR: Attempting procedure call on variable or an undefined procedure" << endl;
-				error = true;
+			// determine signatures on any procedures
+			case wlp4Rule("paramlist dcl"):
+			case wlp4Rule("paramlist dcl COMMA paramlist"):
+				if (child->children[0]->children[0]->rule == TYPE_INT_STAR) {
+					tables[procedure].signature.push_back("int*");
+				}
+				else {
+					tables[procedure].signature.push_back("int");
+				}
+				break;
+
+			// check procedure calls
+			case wlp4Rule("factor ID LPAREN RPAREN"):
+			case wlp4Rule("factor ID LPAREN arglist RPAREN"): {
+				int id = child->children[0]->id;
+				if (!tables[id].declared || variable(id)) {
+					cerr << "ERROR: Attempting procedure call on variable or an undefined procedure" << endl;
+					error = true;
+				}
+				break;
 			}
 		}
 
@@ -169,7 +365,7 @@ bool build(const Tree *t) {
 
 
 // global variables to help type check
-string argProcedure = "";
+int argProcedure = -1;
 int argCount = 0;
 
 // type checking
@@ -177,322 +373,345 @@ string typeOf(Tree *t) {
 
 	string type{"well-typed"};
 
-	// NUM has type "int"
-	if (t->LHS == "NUM") {
-		type = "int";
-	}
-	// NULL has type "int*"
-	else if (t->LHS == "NULL") {
-		type = "int*";
-	}
-	// check on ID => variable
-	else if (t->LHS == "ID") {
-		type = tables[procedure].second[t->lexeme];
-	}
-	// parentheses
-	else if (t->rule == "lvalue LPAREN lvalue RPAREN" || t->rule == "factor LPAREN expr RPAREN") {
-		type = typeOf(t->children[1].get());
-	}
-	else if (t->rule == "expr term" || t->rule == "term factor" || t->rule == "factor ID" || t->rule == "factor NUM" || t->rule == "lvalue ID" || t->rule == "factor NULL") {
-		type = typeOf(t->children[0].get());
-	}
-	// address
-	else if (t->rule == "factor AMP lvalue") {
-		type = typeOf(t->children[1].get());
-		if (type == "int") {
-			type = "int*";
-		}
-		else {
-			if (type != "ERROR") {
-				cerr << "ERROR: Addressing a pointer" << endl;
-				type = "ERROR";
+	switch (t->rule) {
+		// parentheses
+		case wlp4Rule("lvalue LPAREN lvalue RPAREN"):
+		case wlp4Rule("factor LPAREN expr RPAREN"):
+			type = typeOf(t->children[1].get());
+			break;
+		case wlp4Rule("expr term"):
+		case wlp4Rule("term factor"):
+		case wlp4Rule("factor ID"):
+		case wlp4Rule("factor NUM"):
+		case wlp4Rule("lvalue ID"):
+		case wlp4Rule("factor NULL"):
+			type = typeOf(t->children[0].get());
+			break;
+		// address
+		case wlp4Rule("factor AMP lvalue"):
+			type = typeOf(t->children[1].get());
+			if (type == "int") {
+				type = "int*";
 			}
-		}
-	}
-	// dereferencing
-	else if (t->rule == "lvalue STAR factor" || t->rule == "factor STAR factor") {
-		type = typeOf(t->children[1].get());
-		if (type == "int*") {
-			type = "int";
-		}
-		else {
-			if (type != "ERROR") {
-				cerr << "ERROR: Dereferencing a non-pointer" << endl;
-				type = "ERROR";
+			else {
+				if (type != "ERROR") {
+					cerr << "ERROR: Addressing a pointer" << endl;
+					type = "ERROR";
+				}
 			}
-		}
-	}
-	// allocating pointer
-	else if (t->rule == "factor NEW INT LBRACK expr RBRACK") {
-		type = typeOf(t->children[3].get());
-		if (type == "int") {
-			type = "int*";
-		}
-		else {
-			if (type != "ERROR") {
-				cerr << "ERROR: Allocating memory for non-integer" << endl;
-				type = "ERROR";
+			break;
+		// dereferencing
+		case wlp4Rule("lvalue STAR factor"):
+		case wlp4Rule("factor STAR factor"):
+			type = typeOf(t->children[1].get());
+			if (type == "int*") {
+				type = "int";
 			}
-		}
-	}
-	// mult/div/mod operators
-	else if (t->rule == "term term STAR factor" || t->rule == "term term SLASH factor" || t->rule == "term term PCT factor") {
-		string type1 = typeOf(t->children[0].get());
-		string type2 = typeOf(t->children[2].get());
-		if (type1 == "int" && type2 == "int") {
-			type = "int";
-		}
-		else {
-			if (type1 != "ERROR" && type2 != "ERROR") {
-				cerr << "ERROR: Only integers allowed for multiplication, division, or modulo" << endl;
+			else {
+				if (type != "ERROR") {
+					cerr << "ERROR: Dereferencing a non-pointer" << endl;
+					type = "ERROR";
+				}
 			}
-			type = "ERROR";
-		}
-	}
-	// addition
-	else if (t->rule == "expr expr PLUS term") {
-		string type1 = typeOf(t->children[0].get());
-		string type2 = typeOf(t->children[2].get());
-		if (type1 == "ERROR" || type2 == "ERROR") {
-			type = "ERROR";
-		}
-		else if (type1 == "int*" && type2 == "int*") {
-			cerr << "ERROR: Addition on two pointers" << endl;
-			type = "ERROR";
-		}
-		else {
+			break;
+		// allocating pointer
+		case wlp4Rule("factor NEW INT LBRACK expr RBRACK"):
+			type = typeOf(t->children[3].get());
+			if (type == "int") {
+				type = "int*";
+			}
+			else {
+				if (type != "ERROR") {
+					cerr << "ERROR: Allocating memory for non-integer" << endl;
+					type = "ERROR";
+				}
+			}
+			break;
+		// mult/div/mod operators
+		case wlp4Rule("term term STAR factor"):
+		case wlp4Rule("term term SLASH factor"):
+		case wlp4Rule("term term PCT factor"): {
+			string type1 = typeOf(t->children[0].get());
+			string type2 = typeOf(t->children[2].get());
 			if (type1 == "int" && type2 == "int") {
 				type = "int";
 			}
 			else {
-				type = "int*";
+				if (type1 != "ERROR" && type2 != "ERROR") {
+					cerr << "ERROR: Only integers allowed for multiplication, division, or modulo" << endl;
+				}
+				type = "ERROR";
 			}
+			break;
 		}
-	}
-	// subtraction
-	else if (t->rule == "expr expr MINUS term") {       
-		string type1 = typeOf(t->children[0].get());
-		string type2 = typeOf(t->children[2].get());
-		if (type1 == "ERROR" || type2 == "ERROR") {
-			type = "ERROR";
-		}
-		else if (type1 == "int" && type2 == "int*") {       
-			cerr << "ERROR: Subtracting pointer from integer" << endl;
-			type = "ERROR";
-		}        
-		else {			
-			if (type1 == "int*" && type2 == "int") {
-				type = "int*";        
-			}        
-			else {        
-				type = "int"; 
-			}       
-		}        
-	}
-	// procedure call -> at least 1 argument
-	else if (t->rule == "factor ID LPAREN arglist RPAREN") {
-		argCount = 0;
-		argProcedure = t->children[0]->lexeme;
-		if (typeOf(t->children[2].get()) != "ERROR") {
-			type = "int";	
-		}		
-		else {
-			type = "ERROR";
-		}
-	}
-	// arg check
-	else if (t->rule == "arglist expr") {
-		int numArgs = tables[argProcedure].first.size();
-		if (argCount == numArgs - 1) {
-			string currProcedure = argProcedure;
-			int currCount = argCount;
-			type = typeOf(t->children[0].get());
-			if (type != "ERROR") {
-				if (tables[currProcedure].first[currCount] != type) {
-					cerr << "ERROR: Argument type in procedure call not valid" << endl;
-					type = "ERROR";
+		// addition
+		case wlp4Rule("expr expr PLUS term"): {
+			string type1 = typeOf(t->children[0].get());
+			string type2 = typeOf(t->children[2].get());
+			if (type1 == "ERROR" || type2 == "ERROR") {
+				type = "ERROR";
+			}
+			else if (type1 == "int*" && type2 == "int*") {
+				cerr << "ERROR: Addition on two pointers" << endl;
+				type = "ERROR";
+			}
+			else {
+				if (type1 == "int" && type2 == "int") {
+					type = "int";
+				}
+				else {
+					type = "int*";
 				}
 			}
+			break;
 		}
-		else {
-			cerr << "ERROR: Incorrect number of arguments for procedure call" << endl;
-			type = "ERROR";
-		}
-	}
-	// arg check
-	else if (t->rule == "arglist expr COMMA arglist") {
-		int numArgs = tables[argProcedure].first.size();
-		if (argCount < numArgs) {
-			string currProcedure = argProcedure;
-			int currCount = argCount;
-			type = typeOf(t->children[0].get());
-			if (type != "ERROR") {
-				if (tables[currProcedure].first[currCount] == type) {
-					argProcedure = currProcedure;
-					argCount = currCount;
-					argCount += 1;
-					type = typeOf(t->children[2].get());
+		// subtraction
+		case wlp4Rule("expr expr MINUS term"): {
+			string type1 = typeOf(t->children[0].get());
+			string type2 = typeOf(t->children[2].get());
+			if (type1 == "ERROR" || type2 == "ERROR") {
+				type = "ERROR";
+			}
+			else if (type1 == "int" && type2 == "int*") {
+				cerr << "ERROR: Subtracting pointer from integer" << endl;
+				type = "ERROR";
+			}
+			else {
+				if (type1 == "int*" && type2 == "int") {
+					type = "int*";
 				}
 				else {
-					cerr << "ERROR: Argument type in procedure call not valid" << endl;
-					type = "ERROR";
+					type = "int";
 				}
 			}
+			break;
 		}
-		else {
-			cerr << "ERROR: Incorrect number of arguments for procedure call" << endl;
-			type = "ERROR";
-		}
-	}
-	// procedure call -> no args
-	else if (t->rule == "factor ID LPAREN RPAREN") {
-		if (tables[t->children[0]->lexeme].first.size() != 0) {
-			cerr << "ERROR: Sending in arguments to procedure with empty signature" << endl;
-			type = "ERROR";
-		}
-		else {
-			type = "int";
-		}
-	}
-	// comparison operators
-	else if (t->LHS == "test") {
-		string type1 = typeOf(t->children[0].get());
-		string type2 = typeOf(t->children[2].get());
-		if (type1 == "ERROR" || type2 == "ERROR") {
-			type = "ERROR";
-		}
-		else if (type1 == "int" && type2 == "int") {
-			t->type = "int";
-			type = "well-typed";
-		}
-		else if (type1 == "int*" && type2 == "int*") {
-			t->type = "int*";
-			type = "well-typed";
-		}
-		else {
-			cerr << "ERROR: Comparison invalid" << endl;
-			type = "ERROR";
+		// procedure call -> at least 1 argument
+		case wlp4Rule("factor ID LPAREN arglist RPAREN"):
+			argCount = 0;
+			argProcedure = t->children[0]->id;
+			if (typeOf(t->children[2].get()) != "ERROR") {
+				type = "int";
+			}
+			else {
+				type = "ERROR";
+			}
+			break;
+		// arg check
+		case wlp4Rule("arglist expr"): {
+			int numArgs = tables[argProcedure].signature.size();
+			if (argCount == numArgs - 1) {
+				int currProcedure = argProcedure;
+				int currCount = argCount;
+				type = typeOf(t->children[0].get());
+				if (type != "ERROR") {
+					if (tables[currProcedure].signature[currCount] != type) {
+						cerr << "ERROR: Argument type in procedure call not valid" << endl;
+						type = "ERROR";
+					}
+				}
+			}
+			else {
+				cerr << "ERROR: Incorrect number of arguments for procedure call" << endl;
+				type = "ERROR";
+			}
+			break;
+		}
+		// arg check
+		case wlp4Rule("arglist expr COMMA arglist"): {
+			int numArgs = tables[argProcedure].signature.size();
+			if (argCount < numArgs) {
+				int currProcedure = argProcedure;
+				int currCount = argCount;
+				type = typeOf(t->children[0].get());
+				if (type != "ERROR") {
+					if (tables[currProcedure].signature[currCount] == type) {
+						argProcedure = currProcedure;
+						argCount = currCount;
+						argCount += 1;
+						type = typeOf(t->children[2].get());
+					}
+					else {
+						cerr << "ERROR: Argument type in procedure call not valid" << endl;
+						type = "ERROR";
+					}
+				}
+			}
+			else {
+				cerr << "ERROR: Incorrect number of arguments for procedure call" << endl;
+				type = "ERROR";
+			}
+			break;
 		}
-	}
-	// println
-	else if (t->rule == "statement PRINTLN LPAREN expr RPAREN SEMI") {
-		type = typeOf(t->children[2].get());
-		if (type != "ERROR") {
-			if (type != "int") {
-				cerr << "ERROR: Can only print integers" << endl;
+		// procedure call -> no args
+		case wlp4Rule("factor ID LPAREN RPAREN"):
+			if (tables[t->children[0]->id].signature.size() != 0) {
+				cerr << "ERROR: Sending in arguments to procedure with empty signature" << endl;
 				type = "ERROR";
 			}
 			else {
+				type = "int";
+			}
+			break;
+		// comparison operators
+		case wlp4Rule("test expr EQ expr"):
+		case wlp4Rule("test expr NE expr"):
+		case wlp4Rule("test expr LT expr"):
+		case wlp4Rule("test expr LE expr"):
+		case wlp4Rule("test expr GE expr"):
+		case wlp4Rule("test expr GT expr"): {
+			string type1 = typeOf(t->children[0].get());
+			string type2 = typeOf(t->children[2].get());
+			if (type1 == "ERROR" || type2 == "ERROR") {
+				type = "ERROR";
+			}
+			else if (type1 == "int" && type2 == "int") {
+				t->type = "int";
 				type = "well-typed";
 			}
-		}
-	}
-	// assignment
-	else if (t->rule == "statement lvalue BECOMES expr SEMI") {
-		string type1 = typeOf(t->children[0].get());
-		string type2 = typeOf(t->children[2].get());
-		if (type1 == "ERROR" || type2 == "ERROR") {
-			type = "ERROR";	
-		}
-		else if (type1 == type2) {
-			type = "well-typed";
-		}
-		else {
-			cerr << "ERROR: Incorrect assignment type" << endl;
-			type = "ERROR";
-		}
-	}
-	// deallocation
-	else if (t->rule == "statement DELETE LBRACK RBRACK expr SEMI") {
-		type = typeOf(t->children[3].get());
-		if (type != "ERROR") {
-			if (type == "int*") {
+			else if (type1 == "int*" && type2 == "int*") {
+				t->type = "int*";
 				type = "well-typed";
 			}
 			else {
-				cerr << "ERROR: Deallocating non-pointer" << endl;
+				cerr << "ERROR: Comparison invalid" << endl;
 				type = "ERROR";
 			}
+			break;
 		}
-	}
-	// int declaration
-	else if (t->rule == "dcls dcls dcl BECOMES NUM SEMI") {
-		if (t->children[1]->children[0]->rule == "type INT") {
-			type = typeOf(t->children[0].get());
-		}
-		else {
-			cerr << "ERROR: Attempting to declare non-integer with integer" << endl;
-			type = "ERROR";
+		// println
+		case wlp4Rule("statement PRINTLN LPAREN expr RPAREN SEMI"):
+			type = typeOf(t->children[2].get());
+			if (type != "ERROR") {
+				if (type != "int") {
+					cerr << "ERROR: Can only print integers" << endl;
+					type = "ERROR";
+				}
+				else {
+					type = "well-typed";
+				}
+			}
+			break;
+		// assignment
+		case wlp4Rule("statement lvalue BECOMES expr SEMI"): {
+			string type1 = typeOf(t->children[0].get());
+			string type2 = typeOf(t->children[2].get());
+			if (type1 == "ERROR" || type2 == "ERROR") {
+				type = "ERROR";
+			}
+			else if (type1 == type2) {
+				type = "well-typed";
+			}
+			else {
+				cerr << "ERROR: Incorrect assignment type" << endl;
+				type = "ERROR";
+			}
+			break;
 		}
-	}
-	// pointer declaration
-	else if (t->rule == "dcls dcls dcl BECOMES NULL SEMI") {
-                if (t->children[1]->children[0]->rule == "type INT STAR") {
-                        type = typeOf(t->children[0].get());
-                }
-                else {
-                        cerr << "ERROR: Attempting to declare non-pointer with NULL" << endl;
-                        type = "ERROR";
-                }
-        }
-	// procedure definition
-	else if (t->LHS == "procedure") {
-		procedure = t->children[1]->lexeme;
-		type = typeOf(t->children[6].get()); // dcls
-		if (type != "ERROR") {
-			type = typeOf(t->children[7].get()); // statements
+		// deallocation
+		case wlp4Rule("statement DELETE LBRACK RBRACK expr SEMI"):
+			type = typeOf(t->children[3].get());
 			if (type != "ERROR") {
-				type = typeOf(t->children[9].get()); // return expr
-				if (type == "int") {
+				if (type == "int*") {
 					type = "well-typed";
 				}
-				else if (type != "ERROR") {
-					cerr << "ERROR: Returning non-integer from procedure" << endl;
+				else {
+					cerr << "ERROR: Deallocating non-pointer" << endl;
 					type = "ERROR";
 				}
 			}
-		}
-	}
-	// wain definition
-	else if (t->LHS == "main") {
-		procedure = "wain";
-		string dcl2 = t->children[5]->children[0]->rule;
-		if (dcl2 == "type INT") {
-			type = typeOf(t->children[8].get()); // dcls
+			break;
+		// int declaration
+		case wlp4Rule("dcls dcls dcl BECOMES NUM SEMI"):
+			if (t->children[1]->children[0]->rule == TYPE_INT) {
+				type = typeOf(t->children[0].get());
+			}
+			else {
+				cerr << "ERROR: Attempting to declare non-integer with integer" << endl;
+				type = "ERROR";
+			}
+			break;
+		// pointer declaration
+		case wlp4Rule("dcls dcls dcl BECOMES NULL SEMI"):
+			if (t->children[1]->children[0]->rule == TYPE_INT_STAR) {
+				type = typeOf(t->children[0].get());
+			}
+			else {
+				cerr << "ERROR: Attempting to declare non-pointer with NULL" << endl;
+				type = "ERROR";
+			}
+			break;
+		// procedure definition
+		case wlp4Rule("procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE"):
+			enter(t->children[1]->id);
+			type = typeOf(t->children[6].get()); // dcls
 			if (type != "ERROR") {
-                		type = typeOf(t->children[9].get()); // statements
+				type = typeOf(t->children[7].get()); // statements
 				if (type != "ERROR") {
-                			type = typeOf(t->children[11].get()); // return expr
-                			if (type == "int") {
-                        			type = "well-typed";
-                			}
-                			else if (type != "ERROR") {
-                        			cerr << "ERROR: Returning non-integer from wain" << endl;
-                        			type = "ERROR";
-                			}
+					type = typeOf(t->children[9].get()); // return expr
+					if (type == "int") {
+						type = "well-typed";
+					}
+					else if (type != "ERROR") {
+						cerr << "ERROR: Returning non-integer from procedure" << endl;
+						type = "ERROR";
+					}
 				}
 			}
-		}
-		else {
-			cerr << "ERROR: Second argument in wain not an integer" << endl;
-			type = "ERROR";
-		}
-        }
-	else {
-		for (auto &child : t->children) {
-			type = typeOf(child.get());
-			if (type == "ERROR") {
-				break;
-			}	
-		}
+			break;
+		// wain definition
+		case wlp4Rule("main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE"):
+			enter(wain);
+			if (t->children[5]->children[0]->rule == TYPE_INT) {
+				type = typeOf(t->children[8].get()); // dcls
+				if (type != "ERROR") {
+					type = typeOf(t->children[9].get()); // statements
+					if (type != "ERROR") {
+						type = typeOf(t->children[11].get()); // return expr
+						if (type == "int") {
+							type = "well-typed";
+						}
+						else if (type != "ERROR") {
+							cerr << "ERROR: Returning non-integer from wain" << endl;
+							type = "ERROR";
+						}
+					}
+				}
+			}
+			else {
+				cerr << "ERROR: Second argument in wain not an integer" << endl;
+				type = "ERROR";
+			}
+			break;
+		default:
+			switch (t->symbol) {
+				// NUM has type "int"
+				case wlp4Symbol("NUM"):
+					type = "int";
+					break;
+				// NULL has type "int*"
+				case wlp4Symbol("NULL"):
+					type = "int*";
+					break;
+				// check on ID => variable
+				case wlp4Symbol("ID"): {
+					Variable *v = variable(t->id);
+					type = v ? v->type : "";
+					break;
+				}
+				default:
+					for (auto &child : t->children) {
+						type = typeOf(child.get());
+						if (type == "ERROR") {
+							break;
+						}
+					}
+			}
 	}
 	return type;
 }
 
 
-// register symbol table
-map<string, map<string, int>> offsets;
-
 // register offset
 int offsetCount = 0;
 
@@ -509,8 +728,8 @@ int deleteCount = 0;
 int local = 0;
 
 // code(a) -> store value corresponding to variable a from memory into register 3
-void code (string a) {
-	cout << "lw $3, " << offsets[procedure][a] << "($29)" << endl;
+void code (int a) {
+	cout << "lw $3, " << variable(a)->offset << "($29)" << endl;
 }
 
 // push(reg) -> push value stored at reg to memory
@@ -527,147 +746,151 @@ void pop (int reg) {
 
 // function to parse tree and generate code
 void Gen(Tree *t) {
-	
-	// start -> BOF procedures EOF
-	if (t->LHS == "start") {
-		Gen(t->children[1].get()); // procedures
-	}
 
-	else if (t->rule == "procedures procedure procedures") {
-		// Generate procedures first => in order to generate wain at the top of assembly
-		Gen(t->children[1].get());
-		Gen(t->children[0].get());
-	}
-	
-	else if (t->rule == "procedures main") {
-		Gen(t->children[0].get());
-	}
+	switch (t->rule) {
+		// start -> BOF procedures EOF
+		case wlp4Rule("start BOF procedures EOF"):
+			Gen(t->children[1].get()); // procedures
+			break;
 
-	// procedure -> INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
-	else if (t->LHS == "procedure") {
-		procedure = t->children[1]->lexeme;
-		local = 0;
-		Gen(t->children[3].get()); // params
-		cout << "F" << procedure << ":" << endl;
-		cout << "sub $29, $30, $4" << endl;
-		Gen(t->children[6].get()); // dcls
-		Gen(t->children[7].get()); // statements
-		Gen(t->children[9].get()); // expr
-		cout << "add $30, $29, $4" << endl;
-		cout << "jr $31" << endl;
-	}
+		case wlp4Rule("procedures procedure procedures"):
+			// Generate procedures first => in order to generate wain at the top of assembly
+			Gen(t->children[1].get());
+			Gen(t->children[0].get());
+			break;
 
-	// offsets for parameters in procedures
-	else if (t->rule == "params paramlist") {
-		int total = tables[procedure].first.size();
-		int params = 1;
-		Tree *p = t->children[0].get();
-		while (p->rule == "paramlist dcl COMMA paramlist") {
-			offsets[procedure][p->children[0]->children[1]->lexeme] = 4*(total-params+1);
-			++params;
-			p = p->children[2].get();
-		}
-		offsets[procedure][p->children[0]->children[1]->lexeme] = 4*(total-params+1);
-	}
-	
-	// main -> INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
-	else if (t->LHS == "main") {
-		string output;
-
-                // Prologue of wain
-                output = ";Prologue\n";
-                output += ".import print\n";
-		output += ".import init\n";
-		output += ".import new\n";
-		output += ".import delete\n";
-                output += "lis $4\t; $4 will always hold 4\n.word 4\n";
-                output += "lis $10\t; $10 holds address for print\n.word print\n";
-                output += "lis $11\t; $11 will always hold 1\n.word 1\n";
-                output += "sub $29, $30, $4\t; setup frame pointer\n";
-                cout << output;
-
-		procedure = "wain";
-		for (int i = 1; i <= 2; ++i) {
-			cout << "sw $" << i << ", -4($30)" << endl;
-			cout << "sub $30, $30, $4" << endl;
-		}
-		Gen(t->children[3].get()); // first param
-		Gen(t->children[5].get()); // second param
+		case wlp4Rule("procedures main"):
+			Gen(t->children[0].get());
+			break;
+
+		// procedure -> INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
+		case wlp4Rule("procedure INT ID LPAREN params RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE"):
+			enter(t->children[1]->id);
+			local = 0;
+			Gen(t->children[3].get()); // params
+			cout << "F" << identifiers.name(procedure) << ":" << endl;
+			cout << "sub $29, $30, $4" << endl;
+			Gen(t->children[6].get()); // dcls
+			Gen(t->children[7].get()); // statements
+			Gen(t->children[9].get()); // expr
+			cout << "add $30, $29, $4" << endl;
+			cout << "jr $31" << endl;
+			break;
+
+		// offsets for parameters in procedures
+		case wlp4Rule("params paramlist"): {
+			int total = tables[procedure].signature.size();
+			int params = 1;
+			Tree *p = t->children[0].get();
+			while (p->rule == PARAMLIST_MORE) {
+				variable(p->children[0]->children[1]->id)->offset = 4*(total-params+1);
+				++params;
+				p = p->children[2].get();
+			}
+			variable(p->children[0]->children[1]->id)->offset = 4*(total-params+1);
+			break;
+		}
+
+		// main -> INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE
+		case wlp4Rule("main INT WAIN LPAREN dcl COMMA dcl RPAREN LBRACE dcls statements RETURN expr SEMI RBRACE"): {
+			string output;
+
+			// Prologue of wain
+			output = ";Prologue\n";
+			output += ".import print\n";
+			output += ".import init\n";
+			output += ".import new\n";
+			output += ".import delete\n";
+			output += "lis $4\t; $4 will always hold 4\n.word 4\n";
+			output += "lis $10\t; $10 holds address for print\n.word print\n";
+			output += "lis $11\t; $11 will always hold 1\n.word 1\n";
+			output += "sub $29, $30, $4\t; setup frame pointer\n";
+			cout << output;
+
+			enter(wain);
+			for (int i = 1; i <= 2; ++i) {
+				cout << "sw $" << i << ", -4($30)" << endl;
+				cout << "sub $30, $30, $4" << endl;
+			}
+			Gen(t->children[3].get()); // first param
+			Gen(t->children[5].get()); // second param
 
-		// call init
-		cout << ";Prologue init" << endl;
-		if (tables[procedure].first[0] == "int") {
-			cout << "add $2, $0, $0" << endl;
-		}
-		push(31);
-		cout << "lis $5" << endl;
-		cout << ".word init" << endl;
-		cout << "jalr $5" << endl;
-		pop(31);
+			// call init
+			cout << ";Prologue init" << endl;
+			if (tables[procedure].signature[0] == "int") {
+				cout << "add $2, $0, $0" << endl;
+			}
+			push(31);
+			cout << "lis $5" << endl;
+			cout << ".word init" << endl;
+			cout << "jalr $5" << endl;
+			pop(31);
 
 
-		// call rest of wain
-		Gen(t->children[8].get()); // dcls
-		Gen(t->children[9].get()); // statements
-		Gen(t->children[11].get()); // expr
+			// call rest of wain
+			Gen(t->children[8].get()); // dcls
+			Gen(t->children[9].get()); // statements
+			Gen(t->children[11].get()); // expr
 
 
-		 // Epilogue of wain
-                output = ";Epilogue\n";
-                output += "add $30, $29, $4\n";
-                output += "jr $31\n";
-                cout << output;
-	}
-	
-	// enter variable into offsets map
-	else if (t->rule == "dcl type ID") {
-		if (procedure == "wain") {
-			offsets[procedure][t->children[1]->lexeme] = offsetCount;
-			offsetCount -= 4;
+			// Epilogue of wain
+			output = ";Epilogue\n";
+			output += "add $30, $29, $4\n";
+			output += "jr $31\n";
+			cout << output;
+			break;
 		}
-		else {
-			++local;
-			offsets[procedure][t->children[1]->lexeme] = -4*(local-1);
-		}
-	}
-	
-	else if (t->rule == "expr term" || t->rule == "term factor") {
-		Gen(t->children[0].get());
-	}
-	
-	else if (t->rule == "factor ID") {
-		code(t->children[0]->lexeme);
-	}
 
-	// dereference
-	else if (t->rule == "factor STAR factor") {
-		Gen(t->children[1].get());
-		cout << "lw $3, 0($3)" << endl;
-	}
-	
-	else if (t->rule == "factor LPAREN expr RPAREN") {
-		Gen(t->children[1].get());
-	}
+		// assign the variable its offset
+		case wlp4Rule("dcl type ID"):
+			if (procedure == wain) {
+				variable(t->children[1]->id)->offset = offsetCount;
+				offsetCount -= 4;
+			}
+			else {
+				++local;
+				variable(t->children[1]->id)->offset = -4*(local-1);
+			}
+			break;
 
-	// addressing
-	else if (t->rule == "factor AMP lvalue") {
-		Tree *lvalue = t->children[1].get();
-                while (lvalue->rule == "lvalue LPAREN lvalue RPAREN") {
-                        lvalue = lvalue->children[1].get();
-                }
-		if (lvalue->rule == "lvalue ID") {
-			cout << "lis $3" << endl;
-			cout << ".word " << offsets[procedure][lvalue->children[0]->lexeme] << endl;
-			cout << "add $3, $3, $29" << endl;
-		}
-		else if (lvalue->rule == "lvalue STAR factor") {
-			Gen(lvalue->children[1].get());
+		case wlp4Rule("expr term"):
+		case wlp4Rule("term factor"):
+			Gen(t->children[0].get());
+			break;
+
+		case wlp4Rule("factor ID"):
+			code(t->children[0]->id);
+			break;
+
+		// dereference
+		case wlp4Rule("factor STAR factor"):
+			Gen(t->children[1].get());
+			cout << "lw $3, 0($3)" << endl;
+			break;
+
+		case wlp4Rule("factor LPAREN expr RPAREN"):
+			Gen(t->children[1].get());
+			break;
+
+		// addressing
+		case wlp4Rule("factor AMP lvalue"): {
+			Tree *lvalue = t->children[1].get();
+			while (lvalue->rule == LVALUE_PARENS) {
+				lvalue = lvalue->children[1].get();
+			}
+			if (lvalue->rule == LVALUE_ID) {
+				cout << "lis $3" << endl;
+				cout << ".word " << variable(lvalue->children[0]->id)->offset << endl;
+				cout << "add $3, $3, $29" << endl;
+			}
+			else if (lvalue->rule == LVALUE_STAR) {
+				Gen(lvalue->children[1].get());
+			}
+			break;
 		}
-	}
-	
-	// basic operations -> +,-,*,/,% 
-	else if (t->rule == "expr expr PLUS term" || t->rule == "expr expr MINUS term" || t->rule == "term term STAR factor" || t->rule == "term term SLASH factor" || t->rule == "term term PCT factor") {
-		if (t->rule == "expr expr PLUS term") {
+
+		// basic operations -> +,-,*,/,%
+		case wlp4Rule("expr expr PLUS term"): {
 			string type1 = typeOf(t->children[0].get());
 			string type2 = typeOf(t->children[2].get());
 			if (type1 == "int" && type2 == "int") {
@@ -679,8 +902,8 @@ void Gen(Tree *t) {
 			}
 			else if (type1 == "int*" && type2 == "int") {
 				Gen(t->children[0].get());
-                                push(3);
-                                Gen(t->children[2].get());
+				push(3);
+				Gen(t->children[2].get());
 				cout << "mult $3, $4" << endl;
 				cout << "mflo $3" << endl;
 				pop(5);
@@ -688,340 +911,413 @@ void Gen(Tree *t) {
 			}
 			else if (type1 == "int" && type2 == "int*") {
 				Gen(t->children[2].get());
-                                push(3);
-                                Gen(t->children[0].get());
-                                cout << "mult $3, $4" << endl;
-                                cout << "mflo $3" << endl;
-                                pop(5);
-                                cout << "add $3, $5, $3" << endl;
+				push(3);
+				Gen(t->children[0].get());
+				cout << "mult $3, $4" << endl;
+				cout << "mflo $3" << endl;
+				pop(5);
+				cout << "add $3, $5, $3" << endl;
 			}
+			break;
 		}
-		else if (t->rule == "expr expr MINUS term") {
+		case wlp4Rule("expr expr MINUS term"): {
 			string type1 = typeOf(t->children[0].get());
-                        string type2 = typeOf(t->children[2].get());
-                        if (type1 == "int" && type2 == "int") {
-                                Gen(t->children[0].get());
-                                push(3);
-                                Gen(t->children[2].get());
-                                pop(5);
-                                cout << "sub $3, $5, $3" << endl;
-                        }
-                        else if (type1 == "int*" && type2 == "int") {
-                                Gen(t->children[0].get());
-                                push(3);
-                                Gen(t->children[2].get());
-                                cout << "mult $3, $4" << endl;
-                                cout << "mflo $3" << endl;
-                                pop(5);
-                                cout << "sub $3, $5, $3" << endl;
-                        }
-                        else if (type1 == "int*" && type2 == "int*") {
-                                Gen(t->children[0].get());
-                                push(3);
-                                Gen(t->children[2].get());
+			string type2 = typeOf(t->children[2].get());
+			if (type1 == "int" && type2 == "int") {
+				Gen(t->children[0].get());
+				push(3);
+				Gen(t->children[2].get());
+				pop(5);
+				cout << "sub $3, $5, $3" << endl;
+			}
+			else if (type1 == "int*" && type2 == "int") {
+				Gen(t->children[0].get());
+				push(3);
+				Gen(t->children[2].get());
+				cout << "mult $3, $4" << endl;
+				cout << "mflo $3" << endl;
+				pop(5);
+				cout << "sub $3, $5, $3" << endl;
+			}
+			else if (type1 == "int*" && type2 == "int*") {
+				Gen(t->children[0].get());
+				push(3);
+				Gen(t->children[2].get());
 				pop(5);
 				cout << "sub $3, $5, $3" << endl;
 				cout << "div $3, $4" << endl;
 				cout << "mflo $3" << endl;
-                        }
+			}
+			break;
 		}
-		else {
+		case wlp4Rule("term term STAR factor"):
 			Gen(t->children[0].get());
 			push(3);
 			Gen(t->children[2].get());
 			pop(5);
-			if (t->rule == "term term STAR factor") {
-				cout << "mult $5, $3" << endl;
-				cout << "mflo $3" << endl;
+			cout << "mult $5, $3" << endl;
+			cout << "mflo $3" << endl;
+			break;
+		case wlp4Rule("term term SLASH factor"):
+			Gen(t->children[0].get());
+			push(3);
+			Gen(t->children[2].get());
+			pop(5);
+			cout << "div $5, $3" << endl;
+			cout << "mflo $3" << endl;
+			break;
+		case wlp4Rule("term term PCT factor"):
+			Gen(t->children[0].get());
+			push(3);
+			Gen(t->children[2].get());
+			pop(5);
+			cout << "div $5, $3" << endl;
+			cout << "mfhi $3" << endl;
+			break;
+
+		case wlp4Rule("factor NUM"):
+			cout << "lis $3\n.word " << t->children[0]->lexeme << endl;
+			break;
+
+		// set value of NULL to 1
+		case wlp4Rule("factor NULL"):
+			cout << "add $3, $0, $11" << endl;
+			break;
+
+		case wlp4Rule("statements statements statement"):
+			Gen(t->children[0].get());
+			Gen(t->children[1].get());
+			break;
+
+		// print
+		case wlp4Rule("statement PRINTLN LPAREN expr RPAREN SEMI"):
+			push(1);
+			Gen(t->children[2].get());
+			cout << "add $1, $3, $0" << endl;
+			push(31);
+			cout << "jalr $10" << endl;
+			pop(31);
+			pop(1);
+			break;
+
+		// int declarations
+		case wlp4Rule("dcls dcls dcl BECOMES NUM SEMI"):
+			Gen(t->children[0].get());
+			cout << "lis $5" << endl;
+			cout << ".word " << t->children[3]->lexeme << endl;
+			push(5);
+			Gen(t->children[1].get());
+			break;
+
+		// pointer declarations
+		case wlp4Rule("dcls dcls dcl BECOMES NULL SEMI"):
+			Gen(t->children[0].get());
+			cout << "add $5, $0, $11" << endl;
+			push(5);
+			Gen(t->children[1].get());
+			break;
+
+		// assignment
+		case wlp4Rule("statement lvalue BECOMES expr SEMI"): {
+			Tree *lvalue = t->children[0].get();
+			while (lvalue->rule == LVALUE_PARENS) {
+				lvalue = lvalue->children[1].get();
 			}
-			else if (t->rule == "term term SLASH factor") {
-				cout << "div $5, $3" << endl;
-				cout << "mflo $3" << endl;
+			if (lvalue->rule == LVALUE_ID) {
+				Gen(t->children[2].get());
+				cout << "sw $3, " << variable(lvalue->children[0]->id)->offset << "($29)" << endl;
 			}
-			else if (t->rule == "term term PCT factor") {
-				cout << "div $5, $3" << endl;
-				cout << "mfhi $3" << endl;
+			else if (lvalue->rule == LVALUE_STAR) {
+				Gen(t->children[2].get());
+				push(3);
+				Gen(lvalue->children[1].get());
+				pop(5);
+				cout << "sw $5, 0($3)" << endl;
 			}
+			break;
 		}
-	}
-	
-	else if (t->rule == "factor NUM") {
-		cout << "lis $3\n.word " << t->children[0]->lexeme << endl;
-	}
 
-	// set value of NULL to 1
-	else if (t->rule == "factor NULL") {
-		cout << "add $3, $0, $11" << endl;
-	}
-	
-	else if (t->rule == "statements statements statement") {
-		Gen(t->children[0].get());
-		Gen(t->children[1].get());
-	}
-	
-	// print
-	else if (t->rule == "statement PRINTLN LPAREN expr RPAREN SEMI") {
-		push(1);
-		Gen(t->children[2].get());
-		cout << "add $1, $3, $0" << endl;
-		push(31);
-		cout << "jalr $10" << endl;
-		pop(31);
-		pop(1);
-	}
-	
-	// int declarations
-	else if (t->rule == "dcls dcls dcl BECOMES NUM SEMI") {
-		Gen(t->children[0].get());
-		cout << "lis $5" << endl;
-		cout << ".word " << t->children[3]->lexeme << endl;
-		push(5);
-		Gen(t->children[1].get());
-	}
-
-	// pointer declarations
-	else if (t->rule == "dcls dcls dcl BECOMES NULL SEMI") {
-		Gen(t->children[0].get());
-		cout << "add $5, $0, $11" << endl;
-		push(5);
-		Gen(t->children[1].get());
-	}
-
-	// assignment
-	else if (t->rule == "statement lvalue BECOMES expr SEMI") {
-		Tree *lvalue = t->children[0].get();
-		while (lvalue->rule == "lvalue LPAREN lvalue RPAREN") {
-			lvalue = lvalue->children[1].get();
-		}
-		if (lvalue->rule == "lvalue ID") {
+		// comparisons
+		case wlp4Rule("test expr LT expr"):
+			Gen(t->children[0].get());
+			push(3);
 			Gen(t->children[2].get());
-			cout << "sw $3, " << offsets[procedure][lvalue->children[0]->lexeme] << "($29)" << endl;
-		}
-		else if (lvalue->rule == "lvalue STAR factor") {
+			pop(5);
+			if (t->type == "int") {
+				cout << "slt $3, $5, $3" << endl;
+			}
+			else if (t->type == "int*") {
+				cout << "sltu $3, $5, $3" << endl;
+			}
+			break;
+		case wlp4Rule("test expr GT expr"):
+			Gen(t->children[2].get());
+			push(3);
+			Gen(t->children[0].get());
+			pop(5);
+			if (t->type == "int") {
+				cout << "slt $3, $5, $3" << endl;
+			}
+			else if (t->type == "int*") {
+				cout << "sltu $3, $5, $3" << endl;
+			}
+			break;
+		case wlp4Rule("test expr NE expr"):
+			Gen(t->children[0].get());
+			push(3);
 			Gen(t->children[2].get());
+			pop(5);
+			if (t->type == "int") {
+				cout << "slt $6, $3, $5" << endl;
+				cout << "slt $7, $5, $3" << endl;
+			}
+			else if (t->type == "int*") {
+				cout << "sltu $6, $3, $5" << endl;
+				cout << "sltu $7, $5, $3" << endl;
+			}
+			cout << "add $3, $6, $7" << endl;
+			break;
+		case wlp4Rule("test expr EQ expr"):
+			Gen(t->children[0].get());
 			push(3);
-			Gen(lvalue->children[1].get());
+			Gen(t->children[2].get());
 			pop(5);
-			cout << "sw $5, 0($3)" << endl;
+			if (t->type == "int") {
+				cout << "slt $6, $3, $5" << endl;
+				cout << "slt $7, $5, $3" << endl;
+			}
+			else if (t->type == "int*") {
+				cout << "sltu $6, $3, $5" << endl;
+				cout << "sltu $7, $5, $3" << endl;
+			}
+			cout << "add $3, $6, $7" << endl;
+			cout << "sub $3, $11, $3" << endl;
+			break;
+		case wlp4Rule("test expr LE expr"):
+			Gen(t->children[2].get());
+			push(3);
+			Gen(t->children[0].get());
+			pop(5);
+			if (t->type == "int") {
+				cout << "slt $3, $5, $3" << endl;
+			}
+			else if (t->type == "int*") {
+				cout << "sltu $3, $5, $3" << endl;
+			}
+			cout << "sub $3, $11, $3" << endl;
+			break;
+		case wlp4Rule("test expr GE expr"):
+			Gen(t->children[0].get());
+			push(3);
+			Gen(t->children[2].get());
+			pop(5);
+			if (t->type == "int") {
+				cout << "slt $3, $5, $3" << endl;
+			}
+			else if (t->type == "int*") {
+				cout << "sltu $3, $5, $3" << endl;
+			}
+			cout << "sub $3, $11, $3" << endl;
+			break;
+
+		// while statement
+		case wlp4Rule("statement WHILE LPAREN test RPAREN LBRACE statements RBRACE"): {
+			int count = whileCount;
+			++whileCount;
+			cout << "loop" << count << ":" << endl;
+			Gen(t->children[2].get());
+			cout << "beq $3, $0, endWhile" << count << endl;
+			Gen(t->children[5].get());
+			cout << "beq $0, $0, loop" << count << endl;
+			cout << "endWhile" << count << ":" << endl;
+			break;
 		}
-	}
 
-	// comparisons
-	else if (t->rule == "test expr LT expr") {
-		Gen(t->children[0].get());
-		push(3);
-		Gen(t->children[2].get());
-		pop(5);
-		if (t->type == "int") {
-			cout << "slt $3, $5, $3" << endl;
-		}
-		else if (t->type == "int*") {
-			cout << "sltu $3, $5, $3" << endl;
-		}
-	}
-	else if (t->rule == "test expr GT expr") {
-		Gen(t->children[2].get());
-                push(3);
-                Gen(t->children[0].get());
-                pop(5);
-		if (t->type == "int") {
-                	cout << "slt $3, $5, $3" << endl;
-		}
-		else if (t->type == "int*") {
-			cout << "sltu $3, $5, $3" << endl;
-		}
-	}
-	else if (t->rule == "test expr NE expr") {
-		Gen(t->children[0].get());
-		push(3);
-		Gen(t->children[2].get());
-		pop(5);
-		if (t->type == "int") {
-                        cout << "slt $6, $3, $5" << endl;
-                        cout << "slt $7, $5, $3" << endl;
-                }
-                else if (t->type == "int*") {
-                        cout << "sltu $6, $3, $5" << endl;
-                        cout << "sltu $7, $5, $3" << endl;
-                }
-		cout << "add $3, $6, $7" << endl;
-	}
-	else if (t->rule == "test expr EQ expr") {
-		Gen(t->children[0].get());
-                push(3);
-                Gen(t->children[2].get());
-                pop(5);
-                if (t->type == "int") {
-			cout << "slt $6, $3, $5" << endl;
-                	cout << "slt $7, $5, $3" << endl;
-		}
-		else if (t->type == "int*") {
-			cout << "sltu $6, $3, $5" << endl;
-                        cout << "sltu $7, $5, $3" << endl;
+		// if statement
+		case wlp4Rule("statement IF LPAREN test RPAREN LBRACE statements RBRACE ELSE LBRACE statements RBRACE"): {
+			int count = ifCount;
+			++ifCount;
+			Gen(t->children[2].get());
+			cout << "beq $3, $0, else" << count << endl;
+			Gen(t->children[5].get());
+			cout << "beq $0, $0, endif" << count << endl;
+			cout << "else" << count << ":" << endl;
+			Gen(t->children[9].get());
+			cout << "endif" << count << ":" << endl;
+			break;
+		}
+
+		// allocate memory -> call NEW
+		case wlp4Rule("factor NEW INT LBRACK expr RBRACK"):
+			Gen(t->children[3].get());
+			cout << "add $1, $3, $0" << endl;
+			push(31);
+			cout << "lis $5" << endl;
+			cout << ".word new" << endl;
+			cout << "jalr $5" << endl;
+			pop(31);
+			cout << "bne $3, $0, 1" << endl;
+			cout << "add $3, $11, $0" << endl;
+			break;
+
+		// deallocate memory -> call DELETE
+		case wlp4Rule("statement DELETE LBRACK RBRACK expr SEMI"): {
+			int count = deleteCount;
+			++deleteCount;
+			Gen(t->children[3].get());
+			cout << "beq $3, $11, " << "skipDelete" << count << endl;
+			cout << "add $1, $3, $0" << endl;
+			push(31);
+			cout << "lis $5" << endl;
+			cout << ".word delete" << endl;
+			cout << "jalr $5" << endl;
+			pop(31);
+			cout << "skipDelete" << count << ":" << endl;
+			break;
+		}
+
+		// procedure call with no arguments
+		case wlp4Rule("factor ID LPAREN RPAREN"):
+			push(29);
+			push(31);
+			cout << "lis $5" << endl;
+			cout << ".word " << "F" << t->children[0]->lexeme << endl;
+			cout << "jalr $5" << endl;
+			pop(31);
+			pop(29);
+			break;
+
+		// procedure call with arguments
+		case wlp4Rule("factor ID LPAREN arglist RPAREN"): {
+			push(29);
+			push(31);
+			Tree *a = t->children[2].get();
+			while (a->rule == ARGLIST_MORE) {
+				Gen(a->children[0].get());
+				push(3);
+				a = a->children[2].get();
+			}
+			Gen(a->children[0].get());
+			push(3);
+			cout << "lis $5" << endl;
+			cout << ".word " << "F" << t->children[0]->lexeme << endl;
+			cout << "jalr $5" << endl;
+			int params = tables[t->children[0]->id].signature.size();
+			for (int i = 1; i <= params; ++i) {
+				pop(5);
+			}
+			pop(31);
+			pop(29);
+			break;
 		}
-                cout << "add $3, $6, $7" << endl;
-		cout << "sub $3, $11, $3" << endl;
 	}
-	else if (t->rule == "test expr LE expr") {
-		Gen(t->children[2].get());
-                push(3);
-                Gen(t->children[0].get());
-                pop(5);
-		if (t->type == "int") {
-			cout << "slt $3, $5, $3" << endl;
-		}
-		else if (t->type == "int*") {
-			cout << "sltu $3, $5, $3" << endl;
+}
+
+
+// Usage: wlp4gen [--binary] [--time] < foo.wlp4i
+// With --binary the input is a binary parse tree from "wlp4parse --binary-tree" (a .wlp4b file)
+// --time reports how long each pass took on stderr: reading the tree, building the symbol tables, type
+// checking and generating the code
+int main(int argc, char *argv[]) {
+	bool binary = false;
+	bool timing = false;
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i];
+		if (arg == "--binary") {
+			binary = true;
 		}
-		cout << "sub $3, $11, $3" << endl;
-	}
-	else if (t->rule == "test expr GE expr") {
-		Gen(t->children[0].get());
-                push(3);
-                Gen(t->children[2].get());
-                pop(5);
-		if (t->type == "int") {
-			cout << "slt $3, $5, $3" << endl;
+		else if (arg == "--time") {
+			timing = true;
 		}
-		else if (t->type == "int*") {
-			cout << "sltu $3, $5, $3" << endl;
+		else {
+			cerr << "ERROR: Unknown argument " << arg << endl;
+			return 1;
 		}
-		cout << "sub $3, $11, $3" << endl;
 	}
 	
-	// while statement
-	else if (t->rule == "statement WHILE LPAREN test RPAREN LBRACE statements RBRACE") {
-		int count = whileCount;
-		++whileCount;
-		cout << "loop" << count << ":" << endl;
-		Gen(t->children[2].get());
-		cout << "beq $3, $0, endWhile" << count << endl;
-		Gen(t->children[5].get());
-		cout << "beq $0, $0, loop" << count << endl;
-		cout << "endWhile" << count << ":" << endl;
-	}
-
-	// if statement
-	else if (t->rule == "statement IF LPAREN test RPAREN LBRACE statements RBRACE ELSE LBRACE statements RBRACE") {
-		int count = ifCount;
-		++ifCount;
-		Gen(t->children[2].get());
-		cout << "beq $3, $0, else" << count << endl;
-		Gen(t->children[5].get());
-		cout << "beq $0, $0, endif" << count << endl;
-		cout << "else" << count << ":" << endl;
-		Gen(t->children[9].get());
-		cout << "endif" << count << ":" << endl;
-	}
-
-	// allocate memory -> call NEW
-	else if (t->rule == "factor NEW INT LBRACK expr RBRACK") {
-		Gen(t->children[3].get());
-		cout << "add $1, $3, $0" << endl;
-		push(31);
-		cout << "lis $5" << endl;
-		cout << ".word new" << endl;
-		cout << "jalr $5" << endl;
-		pop(31);
-		cout << "bne $3, $0, 1" << endl;
-		cout << "add $3, $11, $0" << endl;
-	}
-
-	// deallocate memory -> call DELETE
-	else if (t->rule == "statement DELETE LBRACK RBRACK expr SEMI") {
-		int count = deleteCount;
-		++deleteCount;
-		Gen(t->children[3].get());
-		cout << "beq $3, $11, " << "skipDelete" << count << endl;
-		cout << "add $1, $3, $0" << endl;
-                push(31);
-                cout << "lis $5" << endl;
-                cout << ".word delete" << endl;
-                cout << "jalr $5" << endl;
-                pop(31);
-                cout << "skipDelete" << count << ":" << endl;
-	}
+	auto last = chrono::steady_clock::now();
+	// function to report the time since the last pass ended
+	auto phase = [&](const char *name) {
+		auto now = chrono::steady_clock::now();
+		if (timing) {
+			cerr << name << " " << chrono::duration<double, milli>(now - last).count() << " ms" << endl;
+		}
+		last = now;
+	};
 
-	// procedure call with no arguments
-	else if (t->rule == "factor ID LPAREN RPAREN") {
-		push(29);
-		push(31);
-		cout << "lis $5" << endl;
-		cout << ".word " << "F" << t->children[0]->lexeme << endl;
-		cout << "jalr $5" << endl;
-		pop(31);
-		pop(29);
+	// create parse tree
+	internGrammar();
+	unique_ptr<Tree> tree;
+	TreeFile file;
+	if (binary) {
+		string error;
+		if (!file.open(0, error)) {
+			cerr << error << endl;
+			return 1;
+		}
+		BinaryReader reader{file};
+		if (!reader.valid()) {
+			cerr << "ERROR: Corrupt binary parse tree" << endl;
+			return 1;
+		}
+		tree = reader.read();
 	}
-
-	// procedure call with arguments
-	else if (t->rule == "factor ID LPAREN arglist RPAREN") {
-		push(29);
-		push(31);
-		Tree *a = t->children[2].get();
-		while (a->rule == "arglist expr COMMA arglist") {
-			Gen(a->children[0].get());
-			push(3);
-			a = a->children[2].get();
-		}
-		Gen(a->children[0].get());
-		push(3);
-		cout << "lis $5" << endl;
-		cout << ".word " << "F" << t->children[0]->lexeme << endl;
-		cout << "jalr $5" << endl;
-		int params = tables[t->children[0]->lexeme].first.size();
-		for (int i = 1; i <= params; ++i) {
-			pop(5);
-		}
-		pop(31);
-		pop(29);
+	else {
+		tree = read();
 	}
-}
-
+	phase("read");
 
-int main() {
-	
-	// create parse tree
-	unique_ptr<Tree> tree = read();
+	// one symbol table per identifier, so procedures and variables are found by id
+	wain = identifiers.intern("wain");
+	tables.resize(identifiers.size());
+	scope.assign(identifiers.size(), -1);
 	
 	bool error{false};
 
 	// build symbol table
 	error = build(tree.get());
+	phase("build");
 
 	string typeResult{"well-typed"};
 
 	// check type if successful tables build
 	if (!error) {
 		typeResult = typeOf(tree.get());
+		phase("types");
 	}
 
 	// generate MIPS code if successful tables build and program well-typed
 	if (!error && typeResult != "ERROR") {
 		Gen(tree.get());
+		cout.flush();
+		phase("gen");
 	}
 
 	/*
 	// print offsets
-	for (auto &it : offsets) {
-		for (auto &it2 : it.second) {
-			cout << it2.first << " " << it2.second << endl;
+	for (auto &it : tables) {
+		for (auto &it2 : it.variables) {
+			cout << identifiers.name(it2.id) << " " << it2.offset << endl;
 		}
 	}
 	
 	// print signatures and variables if no error encountered
 	if (!error && typeResult != "ERROR") {
-		for (auto &it : tables) {
+		for (int i = 0; i < identifiers.size(); ++i) {
+			if (!tables[i].declared) {
+				continue;
+			}
 
 			// print procedure name and signature
-			cerr << it.first << ":";
-			for (auto &it2 : it.second.first) {
+			cerr << identifiers.name(i) << ":";
+			for (auto &it2 : tables[i].signature) {
 				cerr << " " << it2;
 			}
 			cerr << endl;
 
 			// print variables
-			for (auto &it3 : it.second.second) {
-				cerr << it3.first << " " << it3.second << endl;
+			for (auto &it3 : tables[i].variables) {
+				cerr << identifiers.name(it3.id) << " " << it3.type << endl;
 			}
 		}
 	}
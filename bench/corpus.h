@@ -0,0 +1,513 @@
+#ifndef CS241_BENCH_CORPUS_H
+#define CS241_BENCH_CORPUS_H
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstdio>
+#include <algorithm>
+#include <unordered_set>
+
+/* Seeded generators of synthetic compiler input, used by the benchmarks and
+ * corpusgen. For the scanner the output only has to be lexically valid: the
+ * WLP4 corpus is a stream of tokens laid out on lines and the MIPS corpus is
+ * a series of well-formed assembly lines. generateWlp4Program produces
+ * complete, well-typed programs for the parser and code generator, and
+ * generateGrammar grammars for the parse table generator. The same
+ * seed and options always produce the same bytes, on any platform.
+ */
+
+struct CorpusOptions {
+  uint64_t seed = 241;
+  size_t bytes = 1 << 22;         // approximate size of the corpus
+  double identifierDensity = 0.4; // fraction of tokens that are identifiers (labels for MIPS)
+  double numberRatio = 0.15;      // fraction of tokens that are numeric literals
+  double commentRatio = 0.1;      // fraction of lines that end with a comment
+  size_t lineLength = 60;         // target length of a line, in characters
+  double spaceRatio = 1.0;        // fraction of optional spaces between tokens that are kept
+  int statements = 20;            // statements per procedure (generateWlp4Program only)
+  int expressionDepth = 3;        // maximum depth of expressions (generateWlp4Program only)
+  int nesting = 0;                // parentheses around one expression per procedure (generateWlp4Program only)
+  int parameters = 2;             // parameters of each procedure but wain, at least 2 (generateWlp4Program only)
+  int grammarLevels = 8;          // precedence levels of expressions (generateGrammar only)
+  int grammarOperators = 2;       // operators per precedence level (generateGrammar only)
+};
+
+// Named option presets; each one stresses a different part of the DFA
+struct CorpusPreset {
+  const char *name;
+  double identifierDensity;
+  double numberRatio;
+  double commentRatio;
+  size_t lineLength;
+  double spaceRatio;
+};
+
+const CorpusPreset corpusPresets[] = {
+  {"mixed",    0.40, 0.15, 0.10, 60,   1.0},
+  {"idents",   0.85, 0.05, 0.00, 60,   1.0},
+  {"numbers",  0.10, 0.80, 0.00, 60,   1.0},
+  {"comments", 0.30, 0.10, 0.90, 100,  1.0},
+  {"punct",    0.05, 0.05, 0.00, 60,   1.0},
+  {"longlines", 0.40, 0.15, 0.10, 2000, 1.0},
+  {"dense",    0.30, 0.20, 0.00, 60,   0.0}, // short tokens with no spaces, so most characters end a token
+};
+
+// Looks up a preset by name; returns false if there is no such preset
+inline bool applyPreset(const std::string &name, CorpusOptions &options) {
+  for (auto &preset : corpusPresets) {
+    if (name == preset.name) {
+      options.identifierDensity = preset.identifierDensity;
+      options.numberRatio = preset.numberRatio;
+      options.commentRatio = preset.commentRatio;
+      options.lineLength = preset.lineLength;
+      options.spaceRatio = preset.spaceRatio;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Named program shapes for generateWlp4Program; each one stresses a different part of the parser
+struct ProgramShape {
+  const char *name;
+  int statements;
+  int expressionDepth;
+  int nesting;
+  int parameters;
+};
+
+const ProgramShape programShapes[] = {
+  {"default",    20,    3, 0,    2},  // the option defaults
+  {"deep",       4,     3, 5000, 2},  // one expression per procedure nested 5000 parentheses deep
+  {"long",       20000, 3, 0,    2},  // a few procedures with very long statement lists
+  {"procedures", 1,     1, 0,    2},  // thousands of tiny procedures
+  {"wide",       8,     2, 0,    64}, // 64 parameters per procedure, and 64 arguments per call
+};
+
+// Looks up a program shape by name; returns false if there is no such shape
+inline bool applyProgramShape(const std::string &name, CorpusOptions &options) {
+  for (auto &shape : programShapes) {
+    if (name == shape.name) {
+      options.statements = shape.statements;
+      options.expressionDepth = shape.expressionDepth;
+      options.nesting = shape.nesting;
+      options.parameters = shape.parameters;
+      return true;
+    }
+  }
+  return false;
+}
+
+/* Small deterministic generator (splitmix64). The standard distributions are
+ * not specified bit-for-bit, so they are avoided to keep corpora reproducible.
+ */
+class CorpusRandom {
+    uint64_t state;
+
+  public:
+    explicit CorpusRandom(uint64_t seed) : state(seed) {}
+
+    uint64_t next() {
+      uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+      return z ^ (z >> 31);
+    }
+
+    // Uniform integer in [0, n)
+    uint64_t below(uint64_t n) { return next() % n; }
+
+    // Uniform real in [0, 1)
+    double real() { return (next() >> 11) * (1.0 / (1ULL << 53)); }
+
+    bool chance(double p) { return real() < p; }
+};
+
+// Builds a pool of distinct identifiers so that names repeat the way they do in real code
+inline std::vector<std::string> identifierPool(CorpusRandom &random, size_t count,
+                                               const std::vector<std::string> &reserved) {
+  const char letters[] = "abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  const char digits[] = "0123456789";
+  std::vector<std::string> pool;
+  while (pool.size() < count) {
+    std::string name(1, letters[random.below(52)]);
+    size_t length = 1 + random.below(random.chance(0.5) ? 4 : 12);
+    while (name.size() < length) {
+      name += random.chance(0.8) ? letters[random.below(52)] : digits[random.below(10)];
+    }
+    bool clash = false;
+    for (auto &word : reserved) {
+      clash = clash || word == name;
+    }
+    for (auto &used : pool) {
+      clash = clash || used == name;
+    }
+    if (!clash) {
+      pool.push_back(name);
+    }
+  }
+  return pool;
+}
+
+// Text of a comment body of roughly the given length
+inline std::string commentText(CorpusRandom &random, size_t length) {
+  const char *words[] = {"the", "loop", "counter", "while", "if", "pointer", "returns",
+                         "value", "42", "x+y", "(*p)", "{}", "=="};
+  std::string text;
+  while (text.size() < length) {
+    text += ' ';
+    text += words[random.below(sizeof(words) / sizeof(words[0]))];
+  }
+  return text;
+}
+
+/* Generates a WLP4 token stream. Tokens are separated by single spaces (with
+ * a leading tab on most lines), numbers are always within the range the
+ * scanner accepts, and comments use the // form. With spaceRatio below 1
+ * some spaces are left out, but only next to a one-character symbol that
+ * can't join its neighbour into another token.
+ */
+inline std::string generateWlp4(const CorpusOptions &options) {
+  const std::vector<std::string> keywords = {"return", "if", "else", "while", "println",
+                                             "wain", "int", "new", "delete", "NULL"};
+  const char *symbols[] = {"(", ")", "{", "}", "=", "==", "!=", "<", ">", "<=", ">=",
+                           "+", "-", "*", "/", "%", ",", ";", "[", "]", "&"};
+  const size_t symbolCount = sizeof(symbols) / sizeof(symbols[0]);
+  const std::string standalone = "(){}[],;+-*%&";
+  auto joinable = [&standalone](const std::string &token) {
+    return token.size() == 1 && standalone.find(token[0]) != std::string::npos;
+  };
+
+  CorpusRandom random(options.seed);
+  std::vector<std::string> identifiers = identifierPool(random, 512, keywords);
+
+  std::string out;
+  out.reserve(options.bytes + options.lineLength + 64);
+  while (out.size() < options.bytes) {
+    size_t lineStart = out.size();
+    if (random.chance(0.8)) {
+      out += '\t';
+    }
+    std::string previous;
+    for (bool first = true; out.size() - lineStart < options.lineLength; first = false) {
+      std::string token;
+      double kind = random.real();
+      if (kind < options.identifierDensity) {
+        token = identifiers[random.below(identifiers.size())];
+      } else if (kind < options.identifierDensity + options.numberRatio) {
+        // Mostly short literals, with the occasional one near the limit
+        uint64_t limits[] = {10, 1000, 100000, 2147483648ULL};
+        token = std::to_string(random.below(limits[random.below(4)]));
+      } else if (random.chance(0.2)) {
+        token = keywords[random.below(keywords.size())];
+      } else {
+        token = symbols[random.below(symbolCount)];
+      }
+      bool optional = joinable(previous) || joinable(token);
+      if (!first && !(optional && options.spaceRatio < 1 && !random.chance(options.spaceRatio))) {
+        out += ' ';
+      }
+      out += token;
+      previous = token;
+    }
+    if (random.chance(options.commentRatio)) {
+      out += " //";
+      out += commentText(random, 8 + random.below(options.lineLength / 2 + 1));
+    }
+    out += '\n';
+  }
+  return out;
+}
+
+/* Generator of well-formed WLP4 programs for benchmarking the later stages:
+ * every program it produces scans, parses and type checks. Procedures are
+ * added until the program reaches options.bytes, each with
+ * options.statements statements (if and while bodies nest up to three deep),
+ * options.parameters parameters, and, if options.nesting is set, an
+ * assignment of an expression nested that many parentheses deep.
+ */
+class Wlp4ProgramGenerator {
+    const CorpusOptions &options;
+    CorpusRandom random;
+    std::vector<std::string> procedures;
+    std::string out;
+
+    const std::vector<std::string> ints{"a", "x", "y"};
+    const std::vector<std::string> pointers{"b", "q"};
+
+    const std::string &pick(const std::vector<std::string> &v) { return v[random.below(v.size())]; }
+
+    std::string expression(int depth) {
+      switch (random.below(depth > 0 ? 9 : 3)) {
+        case 0: return pick(ints);
+        case 1: return std::to_string(random.below(100000));
+        case 2: return "*" + pick(pointers);
+        case 3: return "(" + expression(depth - 1) + ")";
+        default: {
+          const char *ops[] = {" + ", " - ", " * ", " / ", " % "};
+          std::string left = expression(depth - 1);
+          const char *op = ops[random.below(5)];
+          return left + op + expression(depth - 1);
+        }
+      }
+    }
+
+    std::string test() {
+      const char *ops[] = {" < ", " > ", " <= ", " >= ", " == ", " != "};
+      std::string left = expression(1);
+      const char *op = ops[random.below(6)];
+      return left + op + expression(1);
+    }
+
+    // Each random choice is made in its own statement, since the operands
+    // of + are evaluated in an unspecified order.
+    std::string assignment(int depth) {
+      std::string target = pick(ints);
+      return target + " = " + expression(depth) + ";";
+    }
+
+    // An expression nested n parentheses deep: x + (y - (a + (... (1) ...)))
+    std::string nested(int n) {
+      std::string text;
+      for (int i = 0; i < n; ++i) {
+        text += pick(ints);
+        text += i % 2 ? " - (" : " + (";
+      }
+      text += "1";
+      text.append(n, ')');
+      return text;
+    }
+
+    void line(const std::string &indent, const std::string &text) {
+      out += indent + text + "\n";
+    }
+
+    void statements(int n, const std::string &indent, int depth) {
+      for (int i = 0; i < n; ++i) {
+        if (random.chance(options.commentRatio)) {
+          line(indent, "// comment " + std::to_string(random.below(1000)) + " with words while if");
+        }
+        switch (random.below(10)) {
+          case 0: case 1: case 2:
+            line(indent, assignment(options.expressionDepth));
+            break;
+          case 3:
+            line(indent, "println(" + expression(options.expressionDepth) + ");");
+            break;
+          case 4:
+            if (depth < 3) {
+              line(indent, "if (" + test() + ") {");
+              statements(2, indent + "\t", depth + 1);
+              line(indent, "} else {");
+              statements(1, indent + "\t", depth + 1);
+              line(indent, "}");
+              break;
+            }
+            line(indent, assignment(1));
+            break;
+          case 5:
+            if (depth < 3) {
+              std::string v = pick(ints);
+              line(indent, "while (" + v + " > 0) {");
+              line(indent + "\t", v + " = " + v + " - 1;");
+              statements(1, indent + "\t", depth + 1);
+              line(indent, "}");
+              break;
+            }
+            line(indent, assignment(1));
+            break;
+          case 6:
+            line(indent, "q = new int[" + expression(1) + "];");
+            line(indent, "*q = " + expression(1) + ";");
+            line(indent, "delete [] q;");
+            break;
+          case 7:
+            if (!procedures.empty()) {
+              std::string target = pick(ints);
+              std::string callee = pick(procedures);
+              std::string arguments = expression(1);
+              arguments += ", &" + pick(ints);
+              for (int p = 2; p < options.parameters; ++p) {
+                arguments += ", " + expression(0);
+              }
+              line(indent, target + " = " + callee + "(" + arguments + ");");
+              break;
+            }
+            line(indent, assignment(1));
+            break;
+          case 8:
+            line(indent, "q = &" + pick(ints) + ";");
+            line(indent, "*(q + 0) = " + expression(1) + ";");
+            break;
+          default:
+            line(indent, assignment(1));
+            break;
+        }
+      }
+    }
+
+    void body(const std::string &ret) {
+      line("\t", "int* q = NULL;");
+      if (options.nesting > 0) {
+        line("\t", "x = " + nested(options.nesting) + ";");
+      }
+      statements(options.statements, "\t", 0);
+      line("\t", "return " + ret + ";");
+      line("", "}");
+    }
+
+  public:
+    explicit Wlp4ProgramGenerator(const CorpusOptions &options) :
+      options(options), random(options.seed) {}
+
+    std::string generate() {
+      out.reserve(options.bytes + 4096);
+      while (out.size() < options.bytes) {
+        std::string name = "proc" + std::to_string(procedures.size());
+        std::string parameters = "int a, int* b";
+        for (int p = 2; p < options.parameters; ++p) {
+          parameters += ", int p" + std::to_string(p);
+        }
+        line("", "int " + name + "(" + parameters + ") {");
+        line("\t", "int x = " + std::to_string(random.below(100)) + ";");
+        line("\t", "int y = 0;");
+        body("x + a");
+        procedures.push_back(name);
+      }
+      line("", "int wain(int* b, int a) {");
+      line("\t", "int x = 1;");
+      line("\t", "int y = 2;");
+      body("x");
+      return out;
+    }
+};
+
+inline std::string generateWlp4Program(const CorpusOptions &options) {
+  return Wlp4ProgramGenerator(options).generate();
+}
+
+/* Generates MIPS assembly that the a3 assembler accepts. Label definitions
+ * and label operands come from identifierDensity, .word literals (decimal
+ * and hex) from numberRatio, and everything else is register instructions.
+ * Every label is defined once, and operands only name labels that are
+ * already defined (branches only recent ones, so their offsets stay within
+ * 16 bits). Lines with a comment are padded out to lineLength by the
+ * comment; instructions are never split across lines. With spaceRatio below
+ * 1 some lines leave out the spaces after the label and the commas.
+ */
+inline std::string generateMips(const CorpusOptions &options) {
+  CorpusRandom random(options.seed);
+  std::vector<std::string> pool = identifierPool(random, 256, {});
+  std::vector<std::string> labels;
+  std::unordered_set<std::string> defined;
+  size_t generated = 0;
+
+  auto reg = [&random]() { return "$" + std::to_string(random.below(32)); };
+
+  std::string out;
+  out.reserve(options.bytes + options.lineLength + 64);
+  while (out.size() < options.bytes) {
+    size_t lineStart = out.size();
+    bool spaced = !(options.spaceRatio < 1 && !random.chance(options.spaceRatio));
+    const std::string comma = spaced ? ", " : ",";
+    if (random.chance(options.identifierDensity / 2)) {
+      // Cycle through the pool, numbering the names once it is used up
+      std::string label;
+      do {
+        size_t n = generated++;
+        label = pool[n % pool.size()] + (n < pool.size() ? "" : std::to_string(n / pool.size()));
+      } while (!defined.insert(label).second);
+      labels.push_back(label);
+      out += label + (spaced ? ": " : ":");
+    }
+    double kind = random.real();
+    if (kind < options.numberRatio) {
+      if (random.chance(0.3)) {
+        char hex[16];
+        std::snprintf(hex, sizeof(hex), "0x%llx",
+                      static_cast<unsigned long long>(random.below(1ULL << 32)));
+        out += std::string(".word ") + hex;
+      } else {
+        int64_t value = static_cast<int64_t>(random.below(1ULL << 32)) - (1LL << 31);
+        out += ".word " + std::to_string(value);
+      }
+    } else if (kind < options.numberRatio + options.identifierDensity && !labels.empty()) {
+      size_t recent = labels.size() - random.below(std::min<size_t>(labels.size(), 64)) - 1;
+      switch (random.below(3)) {
+        case 0: out += ".word " + labels[random.below(labels.size())]; break;
+        case 1: out += "beq " + reg() + comma + reg() + comma + labels[recent]; break;
+        default: out += "bne " + reg() + comma + reg() + comma + labels[recent]; break;
+      }
+    } else {
+      switch (random.below(6)) {
+        case 0: out += "add " + reg() + comma + reg() + comma + reg(); break;
+        case 1: out += "slt " + reg() + comma + reg() + comma + reg(); break;
+        case 2: out += "mult " + reg() + comma + reg(); break;
+        case 3: out += "lw " + reg() + comma + std::to_string(4 * random.below(64)) + "(" + reg() + ")"; break;
+        case 4: out += "sw " + reg() + comma + "-" + std::to_string(4 * random.below(64)) + "(" + reg() + ")"; break;
+        default: out += "jr " + reg(); break;
+      }
+    }
+    if (random.chance(options.commentRatio)) {
+      size_t used = out.size() - lineStart + 2;
+      out += " ;";
+      out += commentText(random, used < options.lineLength ? options.lineLength - used : 1);
+    }
+    out += '\n';
+  }
+  return out;
+}
+
+/* Generates the grammar section of a .cfg file for lrgen: statements over
+ * expressions with grammarLevels left-associative precedence levels of
+ * grammarOperators binary operators each, plus calls with argument lists.
+ * The grammar is LALR(1) and SLR(1) without conflicts at any size, and its
+ * tables grow with both numbers (the states for level l are reached from
+ * every operator of the levels below it). It does not depend on the seed.
+ */
+inline std::string generateGrammar(const CorpusOptions &options) {
+  int levels = std::max(1, options.grammarLevels);
+  int operators = std::max(1, options.grammarOperators);
+  std::vector<std::string> terminals = {"BOF", "EOF", "ID", "NUM", "LPAREN", "RPAREN", "LBRACE",
+                                        "RBRACE", "SEMI", "COMMA", "BECOMES", "RETURN"};
+  std::vector<std::string> nonTerminals = {"start", "statements", "statement", "args", "arglist"};
+  std::vector<std::string> rules = {"start BOF statements EOF", "statements", "statements statements statement",
+                                    "statement ID BECOMES expr0 SEMI", "statement LBRACE statements RBRACE",
+                                    "statement RETURN expr0 SEMI"};
+  for (int l = 0; l <= levels; ++l) {
+    std::string expr = "expr" + std::to_string(l);
+    std::string next = "expr" + std::to_string(l + 1);
+    nonTerminals.push_back(expr);
+    if (l == levels) {
+      rules.push_back(expr + " ID");
+      rules.push_back(expr + " NUM");
+      rules.push_back(expr + " LPAREN expr0 RPAREN");
+      rules.push_back(expr + " ID LPAREN args RPAREN");
+      break;
+    }
+    rules.push_back(expr + " " + next);
+    for (int k = 0; k < operators; ++k) {
+      std::string op = "OP" + std::to_string(l) + "_" + std::to_string(k);
+      terminals.push_back(op);
+      rules.push_back(expr + " " + expr + " " + op + " " + next);
+    }
+  }
+  rules.push_back("args");
+  rules.push_back("args arglist");
+  rules.push_back("arglist expr0");
+  rules.push_back("arglist arglist COMMA expr0");
+
+  std::string out;
+  for (auto *list : {&terminals, &nonTerminals}) {
+    out += std::to_string(list->size()) + "\n";
+    for (auto &symbol : *list) {
+      out += symbol + "\n";
+    }
+  }
+  out += "start\n" + std::to_string(rules.size()) + "\n";
+  for (auto &rule : rules) {
+    out += rule + "\n";
+  }
+  return out;
+}
+#endif
@@ -0,0 +1,87 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "corpus.h"
+
+/* Writes a synthetic scanner corpus to standard output, so that the corpora
+ * scanbench measures can also be fed to wlp4scan or asm directly.
+ *
+ *   g++ -std=c++14 -O2 corpusgen.cc -o corpusgen
+ *   ./corpusgen wlp4 --preset mixed --bytes 1000000 --seed 7 > mixed.src
+ *
+ * The first argument is the language (wlp4 or mips), program for a
+ * complete WLP4 program (see generateWlp4Program), or grammar for a .cfg
+ * grammar to feed to lrgen (see generateGrammar). A preset sets all five
+ * ratios at once; --ids, --numbers, --comments, --line-length and --spaces
+ * override individual ones afterwards. --shape (default, deep, long, procedures or
+ * wide) shapes programs the same way, and --statements, --depth, --nesting and
+ * --parameters override it. --levels and --operators size grammars.
+ */
+
+int main(int argc, char **argv) {
+  if (argc < 2 || (std::string(argv[1]) != "wlp4" && std::string(argv[1]) != "mips"
+                    && std::string(argv[1]) != "program" && std::string(argv[1]) != "grammar")) {
+    std::cerr << "ERROR: Usage: corpusgen wlp4|mips|program|grammar [options]" << std::endl;
+    return 1;
+  }
+  std::string language = argv[1];
+  CorpusOptions options;
+
+  for (int i = 2; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) {
+      std::cerr << "ERROR: Missing value for " << arg << std::endl;
+      return 1;
+    }
+    std::string value = argv[++i];
+    if (arg == "--preset") {
+      if (!applyPreset(value, options)) {
+        std::cerr << "ERROR: Unknown preset " << value << std::endl;
+        return 1;
+      }
+    } else if (arg == "--shape") {
+      if (!applyProgramShape(value, options)) {
+        std::cerr << "ERROR: Unknown shape " << value << std::endl;
+        return 1;
+      }
+    } else if (arg == "--bytes") {
+      options.bytes = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg == "--seed") {
+      options.seed = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg == "--ids") {
+      options.identifierDensity = std::atof(value.c_str());
+    } else if (arg == "--numbers") {
+      options.numberRatio = std::atof(value.c_str());
+    } else if (arg == "--comments") {
+      options.commentRatio = std::atof(value.c_str());
+    } else if (arg == "--line-length") {
+      options.lineLength = std::strtoull(value.c_str(), nullptr, 10);
+    } else if (arg == "--spaces") {
+      options.spaceRatio = std::atof(value.c_str());
+    } else if (arg == "--statements") {
+      options.statements = std::atoi(value.c_str());
+    } else if (arg == "--depth") {
+      options.expressionDepth = std::atoi(value.c_str());
+    } else if (arg == "--nesting") {
+      options.nesting = std::atoi(value.c_str());
+    } else if (arg == "--parameters") {
+      options.parameters = std::atoi(value.c_str());
+    } else if (arg == "--levels") {
+      options.grammarLevels = std::atoi(value.c_str());
+    } else if (arg == "--operators") {
+      options.grammarOperators = std::atoi(value.c_str());
+    } else {
+      std::cerr << "ERROR: Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+
+  if (language == "program") {
+    std::cout << generateWlp4Program(options);
+  } else if (language == "grammar") {
+    std::cout << generateGrammar(options);
+  } else {
+    std::cout << (language == "wlp4" ? generateWlp4(options) : generateMips(options));
+  }
+  return 0;
+}
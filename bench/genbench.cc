@@ -0,0 +1,293 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "scanner.h"
+#include "tokenstream.h"
+#include "corpus.h"
+#include "process.h"
+
+/* Code generator throughput benchmark. A well-formed WLP4 program of the
+ * chosen shape is generated from the seed (see generateWlp4Program and
+ * programShapes), scanned, and parsed once by wlp4parse, and its parse tree is
+ * fed to one or more wlp4gen binaries, each run reps times:
+ *
+ *   g++ -std=c++14 -O2 -pthread -I../a5/A5P1 genbench.cc ../a5/A5P1/scanner.cc -o genbench
+ *   ./genbench --gen ../a9/wlp4gen --parser ../a6/A6P5/wlp4parse --bytes 200000
+ *
+ * The best and median wall times are reported as parse tree nodes/s and MB/s
+ * of tree input, with the peak RSS of the generator and a hash of its output
+ * so that runs of different builds can be checked against each other. With
+ * --phases the generators also run with --time, and the best time of each
+ * pass they report (reading the tree, building the symbol tables, type
+ * checking, generating the code) is added to their results. Options:
+ *
+ *   --gen PATH         code generator binary to run (repeatable; default ./wlp4gen), optionally
+ *                      followed by its arguments
+ *   --parser PATH      wlp4parse binary that makes the parse tree (default ./wlp4parse)
+ *   --bytes N          size of the generated program (default 100000)
+ *   --seed N           generator seed (default 241)
+ *   --shape NAME       program shape: default, deep, long, procedures or wide
+ *   --statements N     statements per procedure (default 20)
+ *   --depth N          maximum depth of expressions (default 3)
+ *   --nesting N        parentheses around one expression per procedure (default 0)
+ *   --parameters N     parameters of each procedure (default 2)
+ *   --reps N           timed repetitions per run (default 5)
+ *   --binary           also time the binary parse tree (wlp4parse --binary-tree, wlp4gen --binary)
+ *   --phases           also report the time of each pass (wlp4gen --time)
+ *   -o PATH            write the JSON report to PATH instead of standard output
+ *
+ * The passes of wlp4gen recurse once per level of the tree, so the deep and
+ * long shapes need more than the usual 8 MB stack; the generators run with the
+ * stack limit raised as far as the hard limit allows.
+ */
+
+struct Result {
+  std::string gen;
+  std::string format;
+  size_t inputBytes;
+  size_t nodes;
+  int reps;
+  double best;
+  double median;
+  long peakRssKb;
+  uint64_t outputHash;
+  PhaseTimes phases; // best time of each pass
+};
+
+int main(int argc, char **argv) {
+  CorpusOptions options;
+  options.bytes = 100000;
+  std::vector<std::string> gens;
+  std::string parser = "./wlp4parse";
+  std::string outputPath;
+  int reps = 5;
+  bool binary = false;
+  bool timePhases = false;
+  std::string shape = "default";
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 < argc && arg == "--gen") {
+      gens.push_back(argv[++i]);
+    } else if (i + 1 < argc && arg == "--parser") {
+      parser = argv[++i];
+    } else if (i + 1 < argc && arg == "--bytes") {
+      options.bytes = std::strtoull(argv[++i], nullptr, 10);
+    } else if (i + 1 < argc && arg == "--seed") {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (i + 1 < argc && arg == "--shape") {
+      shape = argv[++i];
+      if (!applyProgramShape(shape, options)) {
+        std::cerr << "ERROR: Unknown shape " << shape << std::endl;
+        return 1;
+      }
+    } else if (i + 1 < argc && arg == "--statements") {
+      options.statements = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--depth") {
+      options.expressionDepth = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--nesting") {
+      options.nesting = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--parameters") {
+      options.parameters = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--reps") {
+      reps = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--binary") {
+      binary = true;
+    } else if (arg == "--phases") {
+      timePhases = true;
+    } else if (i + 1 < argc && arg == "-o") {
+      outputPath = argv[++i];
+    } else {
+      std::cerr << "ERROR: Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (gens.empty()) {
+    gens.push_back("./wlp4gen");
+  }
+  std::vector<std::vector<std::string>> commands;
+  for (auto &gen : gens) {
+    std::vector<std::string> command;
+    if (!resolveCommand(gen, command)) {
+      std::cerr << "ERROR: Cannot find " << gen << std::endl;
+      return 1;
+    }
+    commands.push_back(command);
+    gen.clear();
+    for (auto &w : command) {
+      gen += (gen.empty() ? "" : " ") + w;
+    }
+  }
+  std::vector<std::string> parseCommand;
+  if (!resolveCommand(parser, parseCommand)) {
+    std::cerr << "ERROR: Cannot find " << parser << std::endl;
+    return 1;
+  }
+
+  struct rlimit stack;
+  if (getrlimit(RLIMIT_STACK, &stack) == 0) {
+    stack.rlim_cur = stack.rlim_max;
+    setrlimit(RLIMIT_STACK, &stack);
+  }
+  // the tools are started from a launcher forked while this process is still small (see process.h)
+  startLauncher();
+
+  // Scan the program and parse it once, into both parse tree formats
+  std::string program = generateWlp4Program(options);
+  std::vector<Token> tokens;
+  InternTable identifiers;
+  try {
+    std::istringstream lines(program);
+    std::string line;
+    while (std::getline(lines, line)) {
+      for (auto &token : scan(line, identifiers)) {
+        tokens.push_back(token);
+      }
+    }
+  } catch (ScanningFailure &f) {
+    std::cerr << f.what() << std::endl;
+    return 1;
+  }
+
+  char tokenPath[] = "/tmp/genbench-tokens-XXXXXX";
+  char textPath[] = "/tmp/genbench-text-XXXXXX";
+  char binaryPath[] = "/tmp/genbench-binary-XXXXXX";
+  char outPath[] = "/tmp/genbench-out-XXXXXX";
+  char errPath[] = "/tmp/genbench-err-XXXXXX";
+  close(mkstemp(tokenPath));
+  close(mkstemp(textPath));
+  close(mkstemp(binaryPath));
+  close(mkstemp(outPath));
+  close(mkstemp(errPath));
+  {
+    std::ofstream text(tokenPath);
+    for (auto &token : tokens) {
+      text << tokenKindNames[token.getKind()] << ' ' << token.getLexeme() << '\n';
+    }
+  }
+  long rss = 0;
+  std::vector<std::string> binaryParseCommand = parseCommand;
+  binaryParseCommand.push_back("--binary-tree");
+  if (runCommand(parseCommand, ".", tokenPath, textPath, errPath, rss, nullptr) < 0
+      || (binary && runCommand(binaryParseCommand, ".", tokenPath, binaryPath, errPath, rss, nullptr) < 0)) {
+    std::cerr << "ERROR: " << parser << " failed on the program" << std::endl;
+    unlink(tokenPath);
+    unlink(textPath);
+    unlink(binaryPath);
+    unlink(outPath);
+    unlink(errPath);
+    return 1;
+  }
+  // the .wlp4i text has one line per node
+  size_t nodes = 0;
+  {
+    std::ifstream text(textPath);
+    std::string line;
+    while (std::getline(text, line)) {
+      ++nodes;
+    }
+  }
+
+  std::vector<Result> results;
+  int status = 0;
+  for (size_t g = 0; g < gens.size(); ++g) {
+    const std::string &gen = gens[g];
+    for (int format = 0; format < (binary ? 2 : 1); ++format) {
+      std::string input = format ? binaryPath : textPath;
+      std::ifstream sizeCheck(input, std::ios::binary | std::ios::ate);
+      Result result{gen, format ? "binary" : "text", static_cast<size_t>(sizeCheck.tellg()),
+                    nodes, reps, 0, 0, 0, 0, {}};
+      PhaseTimes phases;
+      PhaseTimes *phasesOut = timePhases ? &phases : nullptr;
+      std::vector<std::string> command = commands[g];
+      if (format) {
+        command.push_back("--binary");
+      }
+      if (timePhases) {
+        command.push_back("--time");
+      }
+
+      // the first run warms the page cache and checks the generator accepts the program
+      if (runCommand(command, ".", input, outPath, errPath, rss, phasesOut) < 0) {
+        std::cerr << "ERROR: " << gen << " failed on the " << result.format << " tree" << std::endl;
+        status = 1;
+        continue;
+      }
+      result.outputHash = hashFile(outPath);
+
+      std::vector<double> times;
+      for (int r = 0; r < reps; ++r) {
+        double t = runCommand(command, ".", input, outPath, errPath, rss, phasesOut);
+        if (t < 0) {
+          std::cerr << "ERROR: " << gen << " failed on the " << result.format << " tree" << std::endl;
+          status = 1;
+          break;
+        }
+        times.push_back(t);
+        result.peakRssKb = std::max(result.peakRssKb, rss);
+        keepBestPhases(result.phases, phases);
+      }
+      if (times.empty()) {
+        continue;
+      }
+      std::sort(times.begin(), times.end());
+      result.reps = times.size();
+      result.best = times.front();
+      result.median = times[times.size() / 2];
+      results.push_back(result);
+      std::cerr << gen << " " << result.format << " done" << std::endl;
+    }
+  }
+  unlink(tokenPath);
+  unlink(textPath);
+  unlink(binaryPath);
+  unlink(outPath);
+  unlink(errPath);
+
+  std::ofstream file;
+  if (!outputPath.empty()) {
+    file.open(outputPath);
+  }
+  std::ostream &out = outputPath.empty() ? std::cout : file;
+  out << "{\n";
+  out << "  \"benchmark\": \"codegen\",\n";
+  out << "  \"timestamp\": " << std::time(nullptr) << ",\n";
+  out << "  \"seed\": " << options.seed << ",\n";
+  out << "  \"shape\": \"" << shape << "\",\n";
+  out << "  \"program_bytes\": " << program.size() << ",\n";
+  out << "  \"tokens\": " << tokens.size() << ",\n";
+  out << "  \"nodes\": " << nodes << ",\n";
+  out << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    char line[1024];
+    std::snprintf(line, sizeof(line),
+                  "%s\n    {\"gen\": \"%s\", \"format\": \"%s\", \"input_bytes\": %zu, "
+                  "\"reps\": %d, \"best_seconds\": %.6f, \"median_seconds\": %.6f, "
+                  "\"nodes_per_s\": %.0f, \"mb_per_s\": %.3f, \"peak_rss_kb\": %ld, "
+                  "\"output_hash\": \"%016llx\"",
+                  i == 0 ? "" : ",", r.gen.c_str(), r.format.c_str(), r.inputBytes, r.reps,
+                  r.best, r.median, r.nodes / r.best, r.inputBytes / r.best / 1e6, r.peakRssKb,
+                  static_cast<unsigned long long>(r.outputHash));
+    out << line;
+    if (!r.phases.empty()) {
+      out << ", \"phases_ms\": {";
+      for (size_t k = 0; k < r.phases.size(); ++k) {
+        std::snprintf(line, sizeof(line), "%s\"%s\": %.3f", k == 0 ? "" : ", ", r.phases[k].first.c_str(),
+                      r.phases[k].second);
+        out << line;
+      }
+      out << "}";
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+  return status;
+}
@@ -0,0 +1,259 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "scanner.h"
+#include "tokenstream.h"
+#include "corpus.h"
+#include "process.h"
+
+/* Parser throughput benchmark. A well-formed WLP4 program of the chosen shape
+ * is generated from the seed (see generateWlp4Program and programShapes),
+ * scanned once, and its token stream is fed to one or more wlp4parse
+ * binaries, each run reps times:
+ *
+ *   g++ -std=c++14 -O2 -pthread -I../a5/A5P1 parsebench.cc ../a5/A5P1/scanner.cc -o parsebench
+ *   ./parsebench --parser ../a6/A6P5/wlp4parse --grammar ../a6/A6P5 --bytes 200000
+ *
+ * The parser runs with the grammar directory as its working directory, since
+ * it loads wlp4.cfg from there, so the times include loading the grammar.
+ * The best and median wall times are reported as tokens/s and MB/s of token
+ * input, with the peak RSS of the parser and a hash of its output so that
+ * runs of different builds can be checked against each other. With --phases
+ * the parsers also run with --time, and the best time of each phase they
+ * report (loading the table, reading the tokens, shifts and reductions alone,
+ * building the tree, writing it) is added to their results. Options:
+ *
+ *   --parser PATH      parser binary to run (repeatable; default ./wlp4parse), optionally
+ *                      followed by its arguments, e.g. --parser "./wlp4parse --table comb"
+ *   --grammar DIR      directory containing wlp4.cfg (default .)
+ *   --bytes N          size of the generated program (default 100000)
+ *   --seed N           generator seed (default 241)
+ *   --shape NAME       program shape: default, deep, long, procedures or wide
+ *   --statements N     statements per procedure (default 20)
+ *   --depth N          maximum depth of expressions (default 3)
+ *   --nesting N        parentheses around one expression per procedure (default 0)
+ *   --parameters N     parameters of each procedure (default 2)
+ *   --reps N           timed repetitions per run (default 5)
+ *   --binary           also time the binary token stream (wlp4parse --binary)
+ *   --phases           also report the time of each phase (wlp4parse --time)
+ *   -o PATH            write the JSON report to PATH instead of standard output
+ */
+
+struct Result {
+  std::string parser;
+  std::string format;
+  size_t inputBytes;
+  size_t tokens;
+  int reps;
+  double best;
+  double median;
+  long peakRssKb;
+  uint64_t outputHash;
+  PhaseTimes phases; // best time of each phase
+};
+
+int main(int argc, char **argv) {
+  CorpusOptions options;
+  options.bytes = 100000;
+  std::vector<std::string> parsers;
+  std::string grammarDir = ".";
+  std::string outputPath;
+  int reps = 5;
+  bool binary = false;
+  bool timePhases = false;
+  std::string shape = "default";
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 < argc && arg == "--parser") {
+      parsers.push_back(argv[++i]);
+    } else if (i + 1 < argc && arg == "--grammar") {
+      grammarDir = argv[++i];
+    } else if (i + 1 < argc && arg == "--bytes") {
+      options.bytes = std::strtoull(argv[++i], nullptr, 10);
+    } else if (i + 1 < argc && arg == "--seed") {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (i + 1 < argc && arg == "--shape") {
+      shape = argv[++i];
+      if (!applyProgramShape(shape, options)) {
+        std::cerr << "ERROR: Unknown shape " << shape << std::endl;
+        return 1;
+      }
+    } else if (i + 1 < argc && arg == "--statements") {
+      options.statements = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--depth") {
+      options.expressionDepth = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--nesting") {
+      options.nesting = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--parameters") {
+      options.parameters = std::atoi(argv[++i]);
+    } else if (i + 1 < argc && arg == "--reps") {
+      reps = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--binary") {
+      binary = true;
+    } else if (arg == "--phases") {
+      timePhases = true;
+    } else if (i + 1 < argc && arg == "-o") {
+      outputPath = argv[++i];
+    } else {
+      std::cerr << "ERROR: Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (parsers.empty()) {
+    parsers.push_back("./wlp4parse");
+  }
+  // split each parser into its path and arguments; the parsers run from the grammar directory,
+  // so resolve their paths first
+  std::vector<std::vector<std::string>> commands;
+  for (auto &parser : parsers) {
+    std::vector<std::string> command;
+    if (!resolveCommand(parser, command)) {
+      std::cerr << "ERROR: Cannot find " << parser << std::endl;
+      return 1;
+    }
+    commands.push_back(command);
+    parser.clear();
+    for (auto &w : command) {
+      parser += (parser.empty() ? "" : " ") + w;
+    }
+  }
+
+  // the parsers are started from a launcher forked while this process is still small (see process.h)
+  startLauncher();
+
+  // Scan the program once and write both token stream formats
+  std::string program = generateWlp4Program(options);
+  std::vector<Token> tokens;
+  InternTable identifiers;
+  try {
+    std::istringstream lines(program);
+    std::string line;
+    while (std::getline(lines, line)) {
+      for (auto &token : scan(line, identifiers)) {
+        tokens.push_back(token);
+      }
+    }
+  } catch (ScanningFailure &f) {
+    std::cerr << f.what() << std::endl;
+    return 1;
+  }
+
+  char textPath[] = "/tmp/parsebench-text-XXXXXX";
+  char binaryPath[] = "/tmp/parsebench-binary-XXXXXX";
+  char outPath[] = "/tmp/parsebench-out-XXXXXX";
+  char errPath[] = "/tmp/parsebench-err-XXXXXX";
+  close(mkstemp(textPath));
+  close(mkstemp(binaryPath));
+  close(mkstemp(outPath));
+  close(mkstemp(errPath));
+  {
+    std::ofstream text(textPath);
+    for (auto &token : tokens) {
+      text << tokenKindNames[token.getKind()] << ' ' << token.getLexeme() << '\n';
+    }
+    std::ofstream bin(binaryPath, std::ios::binary);
+    writeTokenStream(bin, tokens, identifiers);
+  }
+
+  std::vector<Result> results;
+  int status = 0;
+  for (size_t p = 0; p < parsers.size(); ++p) {
+    const std::string &parser = parsers[p];
+    for (int format = 0; format < (binary ? 2 : 1); ++format) {
+      std::string input = format ? binaryPath : textPath;
+      std::ifstream sizeCheck(input, std::ios::binary | std::ios::ate);
+      Result result{parser, format ? "binary" : "text", static_cast<size_t>(sizeCheck.tellg()),
+                    tokens.size(), reps, 0, 0, 0, 0, {}};
+      PhaseTimes phases;
+      PhaseTimes *phasesOut = timePhases ? &phases : nullptr;
+      std::vector<std::string> command = commands[p];
+      if (format) {
+        command.push_back("--binary");
+      }
+      if (timePhases) {
+        command.push_back("--time");
+      }
+
+      // the first run warms the page cache and checks the parser accepts the program
+      long rss = 0;
+      if (runCommand(command, grammarDir, input, outPath, errPath, rss, phasesOut) < 0) {
+        std::cerr << "ERROR: " << parser << " failed on the " << result.format << " input" << std::endl;
+        status = 1;
+        continue;
+      }
+      result.outputHash = hashFile(outPath);
+
+      std::vector<double> times;
+      for (int r = 0; r < reps; ++r) {
+        double t = runCommand(command, grammarDir, input, outPath, errPath, rss, phasesOut);
+        if (t < 0) {
+          std::cerr << "ERROR: " << parser << " failed on the " << result.format << " input" << std::endl;
+          status = 1;
+          break;
+        }
+        times.push_back(t);
+        result.peakRssKb = std::max(result.peakRssKb, rss);
+        keepBestPhases(result.phases, phases);
+      }
+      if (times.empty()) {
+        continue;
+      }
+      std::sort(times.begin(), times.end());
+      result.reps = times.size();
+      result.best = times.front();
+      result.median = times[times.size() / 2];
+      results.push_back(result);
+      std::cerr << parser << " " << result.format << " done" << std::endl;
+    }
+  }
+  unlink(textPath);
+  unlink(binaryPath);
+  unlink(outPath);
+  unlink(errPath);
+
+  std::ofstream file;
+  if (!outputPath.empty()) {
+    file.open(outputPath);
+  }
+  std::ostream &out = outputPath.empty() ? std::cout : file;
+  out << "{\n";
+  out << "  \"benchmark\": \"parser\",\n";
+  out << "  \"timestamp\": " << std::time(nullptr) << ",\n";
+  out << "  \"seed\": " << options.seed << ",\n";
+  out << "  \"shape\": \"" << shape << "\",\n";
+  out << "  \"program_bytes\": " << program.size() << ",\n";
+  out << "  \"tokens\": " << tokens.size() << ",\n";
+  out << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    char line[1024];
+    std::snprintf(line, sizeof(line),
+                  "%s\n    {\"parser\": \"%s\", \"format\": \"%s\", \"input_bytes\": %zu, "
+                  "\"reps\": %d, \"best_seconds\": %.6f, \"median_seconds\": %.6f, "
+                  "\"tokens_per_s\": %.0f, \"mb_per_s\": %.3f, \"peak_rss_kb\": %ld, "
+                  "\"output_hash\": \"%016llx\"",
+                  i == 0 ? "" : ",", r.parser.c_str(), r.format.c_str(), r.inputBytes, r.reps,
+                  r.best, r.median, r.tokens / r.best, r.inputBytes / r.best / 1e6, r.peakRssKb,
+                  static_cast<unsigned long long>(r.outputHash));
+    out << line;
+    if (!r.phases.empty()) {
+      out << ", \"phases_ms\": {";
+      for (size_t k = 0; k < r.phases.size(); ++k) {
+        std::snprintf(line, sizeof(line), "%s\"%s\": %.3f", k == 0 ? "" : ", ", r.phases[k].first.c_str(),
+                      r.phases[k].second);
+        out << line;
+      }
+      out << "}";
+    }
+    out << "}";
+  }
+  out << "\n  ]\n}\n";
+  return status;
+}
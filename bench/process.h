@@ -0,0 +1,297 @@
+#ifndef CS241_BENCH_PROCESS_H
+#define CS241_BENCH_PROCESS_H
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+/* Running the compiler's tools from the benchmarks: parsebench times
+ * wlp4parse and genbench times wlp4gen. Each run is a fork and exec with the
+ * input, output and errors redirected to files, and is timed from the fork to
+ * the end of the wait.
+ *
+ * On Linux the ru_maxrss that wait4 reports for a child includes the copy of
+ * the parent's address space it had before the exec, so a tool forked from a
+ * benchmark that holds a large corpus would report at least the benchmark's
+ * own RSS. The benchmarks therefore call startLauncher first, while they are
+ * still small: it forks a launcher process, and every later run is forked
+ * from the launcher instead, which sends back its time and peak RSS.
+ */
+
+// best (or last) time of each phase a tool reported with --time, in ms, in the order it reported them
+typedef std::vector<std::pair<std::string, double>> PhaseTimes;
+
+// function to read the phase times a tool run with --time wrote to errors ("name time ms" lines)
+// returns false if anything else is there, such as a parse error
+inline bool readPhases(const std::string &errors, PhaseTimes &phases) {
+  std::ifstream in(errors);
+  std::string line;
+  phases.clear();
+  while (std::getline(in, line)) {
+    std::istringstream words(line);
+    std::string name;
+    std::string unit;
+    double ms;
+    if (!(words >> name >> ms >> unit) || unit != "ms" || (words >> unit)) {
+      return false;
+    }
+    phases.emplace_back(name, ms);
+  }
+  return true;
+}
+
+// function to keep the best time of each phase of a run in best
+inline void keepBestPhases(PhaseTimes &best, const PhaseTimes &phases) {
+  for (size_t k = 0; k < phases.size(); ++k) {
+    if (k == best.size()) {
+      best.push_back(phases[k]);
+    }
+    best[k].second = std::min(best[k].second, phases[k].second);
+  }
+}
+
+// function to split a command line ("path args...") into words, with the path made absolute so that the
+// command can run from another directory; returns false if the path doesn't exist
+inline bool resolveCommand(const std::string &line, std::vector<std::string> &command) {
+  std::istringstream words(line);
+  std::string word;
+  command.clear();
+  while (words >> word) {
+    command.push_back(word);
+  }
+  char resolved[PATH_MAX];
+  if (command.empty() || realpath(command[0].c_str(), resolved) == nullptr) {
+    return false;
+  }
+  command[0] = resolved;
+  return true;
+}
+
+// function to fork and exec command with input as stdin, output as stdout and errors as stderr, from
+// directory dir, and wait for it; returns the wall time, or a negative time if it couldn't be started
+// status and peakRssKb are set from wait4
+inline double spawnCommand(const std::vector<std::string> &command, const std::string &dir,
+                           const std::string &input, const std::string &output, const std::string &errors,
+                           int &status, long &peakRssKb) {
+  auto start = std::chrono::steady_clock::now();
+  pid_t pid = fork();
+  if (pid == 0) {
+    int in = open(input.c_str(), O_RDONLY);
+    int out = open(output.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    int err = open(errors.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (in < 0 || out < 0 || err < 0 || chdir(dir.c_str()) != 0) {
+      _exit(127);
+    }
+    dup2(in, 0);
+    dup2(out, 1);
+    dup2(err, 2);
+    std::vector<char *> args;
+    for (auto &arg : command) {
+      args.push_back(const_cast<char *>(arg.c_str()));
+    }
+    args.push_back(nullptr);
+    execv(args[0], args.data());
+    _exit(127);
+  }
+  struct rusage usage;
+  if (pid < 0 || wait4(pid, &status, 0, &usage) != pid) {
+    return -1;
+  }
+  auto stop = std::chrono::steady_clock::now();
+  peakRssKb = usage.ru_maxrss;
+  return std::chrono::duration<double>(stop - start).count();
+}
+
+// function to write all of [data, data + size) to fd; returns false if the pipe closed
+inline bool writeAll(int fd, const void *data, size_t size) {
+  const char *p = static_cast<const char *>(data);
+  while (size > 0) {
+    ssize_t n = write(fd, p, size);
+    if (n <= 0) {
+      return false;
+    }
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+// function to read exactly size bytes from fd into data; returns false if the pipe closed first
+inline bool readAll(int fd, void *data, size_t size) {
+  char *p = static_cast<char *>(data);
+  while (size > 0) {
+    ssize_t n = read(fd, p, size);
+    if (n <= 0) {
+      return false;
+    }
+    p += n;
+    size -= n;
+  }
+  return true;
+}
+
+// a run as the launcher reports it back (see spawnCommand)
+struct LaunchResult {
+  double seconds;
+  int status;
+  long peakRssKb;
+};
+
+// the launcher process and the pipes to it; pid is -1 until startLauncher succeeds
+struct Launcher {
+  pid_t pid = -1;
+  int requests = -1;
+  int results = -1;
+
+  ~Launcher() {
+    if (pid > 0) {
+      close(requests);
+      close(results);
+      waitpid(pid, nullptr, 0);
+    }
+  }
+};
+
+inline Launcher &launcher() {
+  static Launcher instance;
+  return instance;
+}
+
+// function to run the launcher: each request is a word count and that many length-prefixed words,
+// the directory, input, output and errors followed by the command; it ends when the pipe closes
+inline void launcherLoop(int requests, int results) {
+  for (;;) {
+    uint32_t count;
+    if (!readAll(requests, &count, sizeof(count))) {
+      _exit(0);
+    }
+    std::vector<std::string> words(count);
+    for (auto &word : words) {
+      uint32_t length;
+      if (!readAll(requests, &length, sizeof(length))) {
+        _exit(0);
+      }
+      word.resize(length);
+      if (length > 0 && !readAll(requests, &word[0], length)) {
+        _exit(0);
+      }
+    }
+    LaunchResult result{-1, 0, 0};
+    if (words.size() > 4) {
+      std::vector<std::string> command(words.begin() + 4, words.end());
+      result.seconds = spawnCommand(command, words[0], words[1], words[2], words[3], result.status,
+                                    result.peakRssKb);
+    }
+    if (!writeAll(results, &result, sizeof(result))) {
+      _exit(0);
+    }
+  }
+}
+
+// function to fork the launcher that later runs are started from; call it before building any large
+// input, since the launcher's RSS is the floor of every peak RSS it reports
+// returns false (and runs are forked from the caller) if it can't be started
+inline bool startLauncher() {
+  Launcher &l = launcher();
+  int requests[2];
+  int results[2];
+  if (l.pid > 0 || pipe(requests) != 0) {
+    return l.pid > 0;
+  }
+  if (pipe(results) != 0) {
+    close(requests[0]);
+    close(requests[1]);
+    return false;
+  }
+  // keep the pipes out of the commands
+  for (int fd : {requests[0], requests[1], results[0], results[1]}) {
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+  pid_t pid = fork();
+  if (pid == 0) {
+    close(requests[1]);
+    close(results[0]);
+    launcherLoop(requests[0], results[1]);
+  }
+  close(requests[0]);
+  close(results[1]);
+  if (pid < 0) {
+    close(requests[1]);
+    close(results[0]);
+    return false;
+  }
+  l.pid = pid;
+  l.requests = requests[1];
+  l.results = results[0];
+  return true;
+}
+
+// function to run command through the launcher if it was started, or else directly (see spawnCommand)
+inline double launchCommand(const std::vector<std::string> &command, const std::string &dir,
+                            const std::string &input, const std::string &output, const std::string &errors,
+                            int &status, long &peakRssKb) {
+  Launcher &l = launcher();
+  if (l.pid <= 0) {
+    return spawnCommand(command, dir, input, output, errors, status, peakRssKb);
+  }
+  std::vector<std::string> words{dir, input, output, errors};
+  words.insert(words.end(), command.begin(), command.end());
+  std::string request;
+  uint32_t count = words.size();
+  request.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (auto &word : words) {
+    uint32_t length = word.size();
+    request.append(reinterpret_cast<const char *>(&length), sizeof(length));
+    request += word;
+  }
+  LaunchResult result;
+  if (!writeAll(l.requests, request.data(), request.size()) || !readAll(l.results, &result, sizeof(result))) {
+    return -1;
+  }
+  status = result.status;
+  peakRssKb = result.peakRssKb;
+  return result.seconds;
+}
+
+// function to run command once with input as stdin and output as stdout, from directory dir
+// returns the wall time, or a negative time if the command failed; peakRssKb is set from wait4
+// the tools report errors on stderr but still exit with 0, so any message on stderr is a failure,
+// except the phase times when phases is given (the command must then include --time), which it is set to
+inline double runCommand(const std::vector<std::string> &command, const std::string &dir,
+                         const std::string &input, const std::string &output, const std::string &errors,
+                         long &peakRssKb, PhaseTimes *phases) {
+  int status = 0;
+  double seconds = launchCommand(command, dir, input, output, errors, status, peakRssKb);
+  if (seconds < 0) {
+    return -1;
+  }
+  struct stat st;
+  if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || stat(errors.c_str(), &st) != 0
+      || (phases ? !readPhases(errors, *phases) : st.st_size != 0)) {
+    return -1;
+  }
+  return seconds;
+}
+
+// function to hash the contents of a file (FNV-1a)
+inline uint64_t hashFile(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  uint64_t hash = 14695981039346656037ULL;
+  char c;
+  while (in.get(c)) {
+    hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+  }
+  return hash;
+}
+#endif
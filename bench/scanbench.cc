@@ -0,0 +1,385 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "scanner.h"
+#include "corpus.h"
+
+/* Scanner throughput benchmark. The same source is built once per scanner,
+ * picking the scanner with the include path:
+ *
+ *   g++ -std=c++14 -O2 -pthread -I../a5/A5P1 scanbench.cc ../a5/A5P1/scanner.cc -o scanbench-wlp4
+ *   g++ -std=c++14 -O2 -DASM_SCANNER -I../a3 scanbench.cc ../a3/scanner.cc -o scanbench-asm
+ *
+ * Each corpus preset (see corpus.h) is generated from the seed, then every
+ * scanner configuration scans it reps times. The best and median wall times
+ * are reported as MB/s and tokens/s, one JSON object per run. Options:
+ *
+ *   --corpus NAME     run only this preset (repeatable; default: all presets)
+ *   --file PATH       also benchmark an existing source file
+ *   --bytes N         corpus size in bytes (default 4194304)
+ *   --seed N          generator seed (default 241)
+ *   --reps N          timed repetitions per configuration (default 5)
+ *   --threads N       worker threads for the parallel configuration (WLP4 only)
+ *   --boundary        time the token-boundary check alone, then scan the dense preset
+ *   -o PATH           write the JSON report to PATH instead of standard output
+ *
+ * --boundary replays the check the scanner makes each time a token ends, is
+ * the state it stopped in accepting and which kind of token does it make, on
+ * random states of the scanner's DFA: once with the scanner's own constant
+ * mask and array (ScannerStates in scanner.h) and once with the std::set and
+ * throwing switch it used to have. Its results are in the "boundary" corpus,
+ * with tokens_per_s counting checks. Unless --corpus or --file is given, the
+ * dense preset (short tokens with as few spaces as possible) is then scanned
+ * end to end.
+ */
+
+#ifdef ASM_SCANNER
+const char *const scannerName = "asm";
+#else
+const char *const scannerName = "wlp4";
+#endif
+
+struct Corpus {
+  std::string name;
+  std::string text;
+  std::vector<std::string> lines;
+};
+
+struct Result {
+  std::string corpus;
+  std::string config;
+  size_t bytes;
+  size_t lines;
+  size_t tokens;
+  int reps;
+  double best;
+  double median;
+};
+
+// function to split a corpus into lines, the way the tools read their input
+std::vector<std::string> splitLines(const std::string &text) {
+  std::vector<std::string> lines;
+  std::istringstream in(text);
+  std::string line;
+  while (std::getline(in, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+/* function to time one scanner configuration: scanOnce scans the whole
+ * corpus and returns the number of tokens it produced
+ */
+template <typename ScanOnce>
+Result measure(const Corpus &corpus, const std::string &config, int reps, ScanOnce scanOnce) {
+  Result result{corpus.name, config, corpus.text.size(), corpus.lines.size(), 0, reps, 0, 0};
+  result.tokens = scanOnce(); // warm up caches and the static DFA
+  std::vector<double> times;
+  for (int i = 0; i < reps; ++i) {
+    auto start = std::chrono::steady_clock::now();
+    size_t tokens = scanOnce();
+    auto stop = std::chrono::steady_clock::now();
+    if (tokens != result.tokens) {
+      throw ScanningFailure("ERROR: Token count changed between repetitions");
+    }
+    times.push_back(std::chrono::duration<double>(stop - start).count());
+  }
+  std::sort(times.begin(), times.end());
+  result.best = times.front();
+  result.median = times[times.size() / 2];
+  return result;
+}
+
+/* The boundary check as the scanners made it before it became the constant
+ * mask and array of ScannerStates (see scanner.h): a std::set of the
+ * accepting states and a switch that throws on any other state. It is only
+ * kept here, as the baseline the scanner's own check is timed against.
+ */
+struct SetSwitchCheck {
+  typedef ScannerStates S;
+
+#ifdef ASM_SCANNER
+  const std::set<S::State> acceptingStates{S::ID, S::LABEL, S::DOTID, S::HEXINT, S::INT, S::ZERO,
+                                           S::COMMA, S::REG, S::LPAREN, S::RPAREN, S::WHITESPACE,
+                                           S::COMMENT};
+
+  static Token::Kind stateToKind(S::State s) {
+    switch(s) {
+      case S::ID:         return Token::ID;
+      case S::LABEL:      return Token::LABEL;
+      case S::DOTID:      return Token::WORD;
+      case S::COMMA:      return Token::COMMA;
+      case S::LPAREN:     return Token::LPAREN;
+      case S::RPAREN:     return Token::RPAREN;
+      case S::INT:        return Token::INT;
+      case S::ZERO:       return Token::INT;
+      case S::HEXINT:     return Token::HEXINT;
+      case S::REG:        return Token::REG;
+      case S::WHITESPACE: return Token::WHITESPACE;
+      case S::COMMENT:    return Token::COMMENT;
+      default: throw ScanningFailure("ERROR: Cannot convert state to kind.");
+    }
+  }
+#else
+  const std::set<S::State> acceptingStates{S::ID, S::NUM, S::LPAREN, S::RPAREN, S::LBRACE, S::RBRACE,
+                                           S::BECOMES, S::EQ, S::NE, S::LT, S::GT, S::LE, S::GE,
+                                           S::PLUS, S::MINUS, S::STAR, S::SLASH, S::PCT, S::COMMA,
+                                           S::SEMI, S::LBRACK, S::RBRACK, S::AMP, S::WHITESPACE,
+                                           S::COMMENT, S::ZERO};
+
+  static Token::Kind stateToKind(S::State s) {
+    switch(s) {
+      case S::ID:         return Token::ID;
+      case S::NUM:        return Token::NUM;
+      case S::LPAREN:     return Token::LPAREN;
+      case S::RPAREN:     return Token::RPAREN;
+      case S::LBRACE:     return Token::LBRACE;
+      case S::RBRACE:     return Token::RBRACE;
+      case S::BECOMES:    return Token::BECOMES;
+      case S::EQ:         return Token::EQ;
+      case S::NE:         return Token::NE;
+      case S::LT:         return Token::LT;
+      case S::GT:         return Token::GT;
+      case S::LE:         return Token::LE;
+      case S::GE:         return Token::GE;
+      case S::PLUS:       return Token::PLUS;
+      case S::MINUS:      return Token::MINUS;
+      case S::STAR:       return Token::STAR;
+      case S::SLASH:      return Token::SLASH;
+      case S::PCT:        return Token::PCT;
+      case S::COMMA:      return Token::COMMA;
+      case S::SEMI:       return Token::SEMI;
+      case S::LBRACK:     return Token::LBRACK;
+      case S::RBRACK:     return Token::RBRACK;
+      case S::AMP:        return Token::AMP;
+      case S::WHITESPACE: return Token::WHITESPACE;
+      case S::COMMENT:    return Token::COMMENT;
+      case S::ZERO:       return Token::NUM;
+      default: throw ScanningFailure("ERROR: Cannot convert state to kind.");
+    }
+  }
+#endif
+
+  bool accept(S::State s) const { return acceptingStates.count(s) > 0; }
+};
+
+// the kinds of the accepted states, summed where the optimizer can't drop them
+volatile size_t boundarySink;
+
+/* function to time the token-boundary check alone on 2^20 random states of
+ * the scanner's DFA, replayed passes times per repetition: the scanner's own
+ * ScannerStates::accept and stateToKind, and the set and switch baseline.
+ * Both are first run on every state, and any difference is an error.
+ */
+void benchmarkBoundary(const CorpusOptions &options, int reps, int passes, std::vector<Result> &results) {
+  typedef ScannerStates S;
+  const SetSwitchCheck baseline;
+  CorpusRandom random(options.seed);
+  std::vector<S::State> states(1 << 20);
+  for (auto &s : states) {
+    s = static_cast<S::State>(random.below(S::LARGEST_STATE + 1));
+  }
+  for (auto s : states) {
+    if (baseline.accept(s) != S::accept(s) || (S::accept(s) && baseline.stateToKind(s) != S::stateToKind(s))) {
+      throw ScanningFailure("ERROR: The boundary checks disagree on state " + std::to_string(s));
+    }
+  }
+
+  Corpus corpus{"boundary", "", {}};
+  results.push_back(measure(corpus, "set-switch", reps, [&baseline, &states, passes]() {
+    size_t kinds = 0;
+    for (int p = 0; p < passes; ++p) {
+      for (auto s : states) {
+        if (baseline.accept(s)) {
+          kinds += baseline.stateToKind(s);
+        }
+      }
+    }
+    boundarySink = kinds;
+    return states.size() * passes;
+  }));
+  results.push_back(measure(corpus, "bitmask-array", reps, [&states, passes]() {
+    size_t kinds = 0;
+    for (int p = 0; p < passes; ++p) {
+      for (auto s : states) {
+        if (S::accept(s)) {
+          kinds += S::stateToKind(s);
+        }
+      }
+    }
+    boundarySink = kinds;
+    return states.size() * passes;
+  }));
+}
+
+// function to run every configuration of the scanner under test on a corpus
+void benchmark(const Corpus &corpus, int reps, int threads, std::vector<Result> &results) {
+  results.push_back(measure(corpus, "lines", reps, [&corpus]() {
+    size_t tokens = 0;
+    for (auto &line : corpus.lines) {
+      tokens += scan(line).size();
+    }
+    return tokens;
+  }));
+#ifndef ASM_SCANNER
+  results.push_back(measure(corpus, "lines-interned", reps, [&corpus]() {
+    InternTable identifiers;
+    size_t tokens = 0;
+    for (auto &line : corpus.lines) {
+      tokens += scan(line, identifiers).size();
+    }
+    return tokens;
+  }));
+  results.push_back(measure(corpus, "parallel-" + std::to_string(threads), reps,
+                            [&corpus, threads]() {
+    InternTable identifiers;
+    return scanParallel(corpus.text, identifiers, threads).size();
+  }));
+#else
+  // the MIPS scanner has no parallel scan
+  (void)threads;
+#endif
+}
+
+// function to write a string as a JSON string literal
+std::string jsonString(const std::string &s) {
+  std::string out = "\"";
+  for (char c : s) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      char escape[8];
+      std::snprintf(escape, sizeof(escape), "\\u%04x", c);
+      out += escape;
+    } else {
+      out += c;
+    }
+  }
+  return out + "\"";
+}
+
+void writeReport(std::ostream &out, const CorpusOptions &options, int threads,
+                 const std::vector<Result> &results) {
+  out << "{\n";
+  out << "  \"benchmark\": \"scanner\",\n";
+  out << "  \"scanner\": " << jsonString(scannerName) << ",\n";
+  out << "  \"timestamp\": " << std::time(nullptr) << ",\n";
+  out << "  \"compiler\": " << jsonString(__VERSION__) << ",\n";
+  out << "  \"seed\": " << options.seed << ",\n";
+  out << "  \"threads\": " << threads << ",\n";
+  out << "  \"results\": [";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const Result &r = results[i];
+    char line[512];
+    std::snprintf(line, sizeof(line),
+                  "%s\n    {\"corpus\": %s, \"config\": %s, \"bytes\": %zu, \"lines\": %zu, "
+                  "\"tokens\": %zu, \"reps\": %d, \"best_seconds\": %.6f, "
+                  "\"median_seconds\": %.6f, \"mb_per_s\": %.3f, \"tokens_per_s\": %.0f}",
+                  i == 0 ? "" : ",", jsonString(r.corpus).c_str(), jsonString(r.config).c_str(),
+                  r.bytes, r.lines, r.tokens, r.reps, r.best, r.median,
+                  r.bytes / r.best / 1e6, r.tokens / r.best);
+    out << line;
+  }
+  out << "\n  ]\n}\n";
+}
+
+int main(int argc, char **argv) {
+  CorpusOptions options;
+  std::vector<std::string> presets;
+  std::vector<std::string> files;
+  std::string outputPath;
+  int reps = 5;
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  bool boundary = false;
+
+  for (int i = 1; i < argc; ++i) {
+    std::string arg = argv[i];
+    if (i + 1 < argc && arg == "--corpus") {
+      CorpusOptions check;
+      if (!applyPreset(argv[++i], check)) {
+        std::cerr << "ERROR: Unknown corpus " << argv[i] << std::endl;
+        return 1;
+      }
+      presets.push_back(argv[i]);
+    } else if (i + 1 < argc && arg == "--file") {
+      files.push_back(argv[++i]);
+    } else if (i + 1 < argc && arg == "--bytes") {
+      options.bytes = std::strtoull(argv[++i], nullptr, 10);
+    } else if (i + 1 < argc && arg == "--seed") {
+      options.seed = std::strtoull(argv[++i], nullptr, 10);
+    } else if (i + 1 < argc && arg == "--reps") {
+      reps = std::max(1, std::atoi(argv[++i]));
+    } else if (i + 1 < argc && arg == "--threads") {
+      threads = std::max(1, std::atoi(argv[++i]));
+    } else if (arg == "--boundary") {
+      boundary = true;
+    } else if (i + 1 < argc && arg == "-o") {
+      outputPath = argv[++i];
+    } else {
+      std::cerr << "ERROR: Unknown argument " << arg << std::endl;
+      return 1;
+    }
+  }
+  if (presets.empty() && files.empty() && boundary) {
+    presets.push_back("dense");
+  } else if (presets.empty() && files.empty()) {
+    for (auto &preset : corpusPresets) {
+      presets.push_back(preset.name);
+    }
+  }
+
+  std::vector<Result> results;
+  try {
+    if (boundary) {
+      benchmarkBoundary(options, reps, 50, results);
+      std::cerr << "boundary done" << std::endl;
+    }
+    for (auto &name : presets) {
+      Corpus corpus;
+      corpus.name = name;
+      CorpusOptions corpusOptions = options;
+      applyPreset(name, corpusOptions);
+#ifdef ASM_SCANNER
+      corpus.text = generateMips(corpusOptions);
+#else
+      corpus.text = generateWlp4(corpusOptions);
+#endif
+      corpus.lines = splitLines(corpus.text);
+      benchmark(corpus, reps, threads, results);
+      std::cerr << name << " done" << std::endl;
+    }
+    for (auto &path : files) {
+      std::ifstream in(path);
+      if (!in) {
+        std::cerr << "ERROR: Cannot open " << path << std::endl;
+        return 1;
+      }
+      std::stringstream contents;
+      contents << in.rdbuf();
+      Corpus corpus{path, contents.str(), {}};
+      corpus.lines = splitLines(corpus.text);
+      benchmark(corpus, reps, threads, results);
+      std::cerr << path << " done" << std::endl;
+    }
+  } catch (ScanningFailure &f) {
+    std::cerr << f.what() << std::endl;
+    return 1;
+  }
+
+  if (outputPath.empty()) {
+    writeReport(std::cout, options, threads, results);
+  } else {
+    std::ofstream out(outputPath);
+    writeReport(out, options, threads, results);
+  }
+  return 0;
+}